@@ -47,6 +47,7 @@ typedef enum {
 class DataElement {
 
     friend class Packet;
+    friend class FormatDescriptor;
 
  public:
 
@@ -105,6 +106,7 @@ class DataElement {
     DataType type;
     uint64_t array_len;
     bool destroy_data;
+    bool buf_ref;       /* val.p points into a Packet buffer, never freed */
 };
 
 DataType Fmt2Type(const char * cur_fmt);
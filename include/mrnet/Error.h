@@ -39,6 +39,7 @@ typedef enum {
     ERR_PACKING,
     ERR_INTERNAL,
     ERR_SYSTEM,
+    ERR_WOULDBLOCK,
     ERR_CODE_LAST
 } ErrorCode;
 
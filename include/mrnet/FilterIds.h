@@ -18,7 +18,16 @@ extern FilterId TFILTER_AVG;
 extern FilterId TFILTER_MIN;
 extern FilterId TFILTER_MAX;
 extern FilterId TFILTER_ARRAY_CONCAT;
+extern FilterId TFILTER_ARRAY_SUM;
+extern FilterId TFILTER_ARRAY_MIN;
+extern FilterId TFILTER_ARRAY_MAX;
+extern FilterId TFILTER_ARRAY_AVG;
+extern FilterId TFILTER_FIELD_REDUCE;
+extern FilterId TFILTER_QUANTILE_SKETCH;  // merges QuantileSketch packets
+extern FilterId TFILTER_TOP_K;            // merges TopKSketch packets
+extern FilterId TFILTER_HYPERLOGLOG;      // merges HyperLogLog packets
 extern FilterId TFILTER_INT_EQ_CLASS;
+extern FilterId TFILTER_RANGE_EQ_CLASS;   // TFILTER_INT_EQ_CLASS with rank ranges
 extern FilterId TFILTER_EPK_UNIFY;
 extern FilterId TFILTER_PERFDATA;
 extern FilterId TFILTER_TOPO_UPDATE;
@@ -29,6 +38,32 @@ extern FilterId SFILTER_DONTWAIT;
 extern FilterId SFILTER_WAITFORALL;
 extern FilterId SFILTER_TIMEOUT;
 
+/* Waits for a packet from each child like SFILTER_WAITFORALL, but when the
+ * upstream filter has an incremental mode, folds each packet into its wave
+ * as soon as it arrives instead of queueing it. The wave's result is sent
+ * once every child contributed, or after the optional timeout set with
+ * set_FilterParameters( FILTER_SYNC, "%ud", timeout_ms ).
+ *
+ * The built-in SUM, AVG, MIN, MAX, ARRAY_SUM/AVG/MIN/MAX, QUANTILE_SKETCH,
+ * TOP_K, HYPERLOGLOG and RANGE_EQ_CLASS filters have an incremental mode. A filter loaded from a shared object has one when
+ * the object also defines, for filter "f":
+ *
+ *   void f_accumulate( const PacketPtr & ipacket, void ** wave_data,
+ *                      void ** client_data, PacketPtr & params,
+ *                      const TopologyLocalInfo & info );
+ *   void f_finalize( void ** wave_data,
+ *                    std::vector< PacketPtr > & opackets,
+ *                    std::vector< PacketPtr > & opackets_reverse,
+ *                    void ** client_data, PacketPtr & params,
+ *                    const TopologyLocalInfo & info );
+ *
+ * '*wave_data' is NULL for the first packet of a wave. f_finalize() emits
+ * the wave's result and frees '*wave_data'. Packets of a wave are folded
+ * in arrival order. Without an incremental mode, the stream synchronizes
+ * as with SFILTER_WAITFORALL.
+ */
+extern FilterId SFILTER_INCREMENTAL;
+
 } // namespace MRN
 
 #endif  // MRN_FILTERS_H
@@ -0,0 +1,78 @@
+/****************************************************************************
+ *  Copyright 2003-2015 Dorian C. Arnold, Philip C. Roth, Barton P. Miller  *
+ *                  Detailed MRNet usage rights in "LICENSE" file.          *
+ ****************************************************************************/
+
+#if !defined(__hyperloglog_h)
+#define __hyperloglog_h 1
+
+#include <vector>
+
+#include "mrnet/Packet.h"
+#include "mrnet/Types.h"
+
+namespace MRN
+{
+
+class Stream;
+
+/*
+ * HyperLogLog sketch estimating the number of distinct identifiers (file
+ * paths, addresses, host names, ...), aggregated by the TFILTER_HYPERLOGLOG
+ * filter.
+ *
+ * The sketch is 2^precision one-byte registers (precision 4 to 18,
+ * default 12, i.e. 4 KB), sent as a "%Auc" array of that fixed size. The
+ * standard error of get_Estimate() is about 1.04 / sqrt(2^precision),
+ * 1.6% by default, however many identifiers are added.
+ *
+ * Back-ends add() identifiers and send() the sketch. Each parent keeps
+ * the register-wise max of a wave, which is the sketch of the union of
+ * the identifiers, and the front-end calls unpack() on the received
+ * packet and get_Estimate(). Sketches of different precisions cannot be
+ * merged.
+ */
+class HyperLogLog {
+
+ public:
+
+    // BEGIN MRNET API
+
+    HyperLogLog( unsigned int iprecision=12 );
+
+    /* identifiers are hashed the same way by the lightweight library */
+    void add( const void * idata, size_t ilen );
+    void add_String( const char * istr );
+    void add_Value( uint64_t ivalue );
+    void add_Hash( uint64_t ihash );    // an already uniform 64-bit hash
+    void clear(void);
+
+    /* returns -1 if the precisions differ */
+    int merge( const HyperLogLog & isketch );
+    int merge( const PacketPtr & ipacket );
+
+    /* replaces this sketch by the one in 'ipacket', including its
+       precision. Returns -1 if it holds no sketch */
+    int unpack( const PacketPtr & ipacket );
+
+    int send( Stream * istrm, int itag ) const;
+    PacketPtr get_Packet( unsigned int istream_id, int itag ) const;
+
+    double get_Estimate(void) const;
+
+    unsigned int get_Precision(void) const { return _precision; }
+
+    // END MRNET API
+
+ private:
+
+    void set_Precision( unsigned int iprecision );
+    void merge_Registers( const unsigned char * iregisters );
+
+    unsigned int _precision;
+    std::vector< unsigned char > _registers;
+};
+
+} // namespace MRN
+
+#endif /* __hyperloglog_h */
@@ -10,10 +10,13 @@
 #include "mrnet/Error.h"
 #include "mrnet/Event.h"
 #include "mrnet/FilterIds.h"
+#include "mrnet/HyperLogLog.h"
 #include "mrnet/Network.h"
 #include "mrnet/NetworkTopology.h"
 #include "mrnet/Packet.h"
+#include "mrnet/QuantileSketch.h"
 #include "mrnet/Stream.h"
+#include "mrnet/TopKSketch.h"
 #include "mrnet/Tree.h"
 #include "mrnet/Types.h"
 
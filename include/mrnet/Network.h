@@ -48,6 +48,8 @@ class Stream;
 class PerfDataMgr;
 class PeerNode;
 class FilterInfo;
+class FilterExecutor;
+class IOEngine;
 typedef boost::shared_ptr< PeerNode > PeerNodePtr; 
 typedef boost::shared_ptr<std::map< unsigned short, FilterInfo > > FilterInfoPtr;
 
@@ -101,11 +103,13 @@ class Network: public Error {
     Stream* new_Stream( Communicator*,
                         int us_filter_id=TFILTER_NULL,
                         int sync_id=SFILTER_WAITFORALL,
-                        int ds_filter_id=TFILTER_NULL );
+                        int ds_filter_id=TFILTER_NULL,
+                        stream_priority_t priority=STREAM_PRIORITY_NORMAL );
     Stream* new_Stream( Communicator* icomm,
                         std::string us_filters,
                         std::string sync_filters,
-                        std::string ds_filters );
+                        std::string ds_filters,
+                        stream_priority_t priority=STREAM_PRIORITY_NORMAL );
     Stream* get_Stream( unsigned int iid ) const;
     int recv( int* otag, PacketPtr& opacket, Stream** ostream, bool iblocking=true );
 
@@ -115,6 +119,10 @@ class Network: public Error {
     int send( Rank ibe, PacketPtr& ipacket );
     int flush(void) const;
 
+    /* Send queue occupancy and high-water marks for the link to a
+       parent or child peer, returns -1 if irank is not a peer */
+    int get_PeerQueueStats( Rank irank, queue_stats_t & ostats );
+
     /* Performance data collection */
     bool enable_PerformanceData( perfdata_metric_t metric, perfdata_context_t context );
     bool disable_PerformanceData( perfdata_metric_t metric, perfdata_context_t context );
@@ -266,6 +274,8 @@ protected:
     friend class Router;
     friend class PeerNode;
     friend class EventDetector;
+    friend class IOEngine;
+    friend class FilterExecutor;
     friend class RSHParentNode;
     friend class RSHChildNode;
     friend class RSHInternalNode;
@@ -296,7 +306,8 @@ protected:
                          unsigned int inum_backends,
                          unsigned short ius_filter_id,
                          unsigned short isync_filter_id,
-                         unsigned short ids_filter_id);
+                         unsigned short ids_filter_id,
+                         stream_priority_t ipriority=STREAM_PRIORITY_NORMAL );
     void delete_Stream( unsigned int );
     bool have_Streams(void);
     bool update_Streams(void);
@@ -390,6 +401,8 @@ protected:
 
     void waitOn_ProtEvent(void);
     static std::string get_NetSettingName( int s );
+    IOEngine* get_IOEngine(void);
+    FilterExecutor* get_FilterExecutor( bool icreate = true );
     void signal_ProtEvent(std::vector<char *> hostnames, 
                           std::vector<char *> so_names, 
                           std::vector<unsigned> func_ids);
@@ -425,9 +438,33 @@ protected:
     mutable std::vector<char *> _filter_error_hosts;
     mutable std::vector<char *> _filter_error_sonames;;
     mutable std::vector<unsigned> _filter_error_funcids;
+    bool _prot_event_signaled;
 
     int _startup_timeout;
     int _topo_update_timeout_msec;
+    /* send coalescing policy for peer send threads (0 usec disables) */
+    unsigned int _send_coalesce_usec;
+    unsigned int _send_coalesce_bytes;
+    unsigned int _send_coalesce_packets;
+    /* optional epoll I/O engine serving the child links (Linux only),
+       used when the local node type is in _io_engine_nodes, a bitmask
+       of (1 << node_type_t) */
+    IOEngine* _io_engine;
+    unsigned int _io_engine_nodes;
+    unsigned int _io_engine_workers;
+    /* peer send queue limits, user data senders wait while a queue is at
+       either limit (0 means unbounded) */
+    unsigned int _send_queue_max_packets;
+    unsigned int _send_queue_max_bytes;
+    /* user data packets with larger payloads are sent to children in
+       fragments of this size (0 disables fragmentation) */
+    unsigned int _send_fragment_bytes;
+    /* optional worker pool running the upstream filters of a parent node,
+       with the number of workers for each parent node type (0 filters
+       inline in the receiving threads) */
+    FilterExecutor* _filter_executor;
+    unsigned int _filter_threads_fe;
+    unsigned int _filter_threads_cp;
     /* EventPipe notifications */
     std::map< EventClass, EventPipe* > _evt_pipes;
 
@@ -437,6 +474,8 @@ protected:
     mutable XPlat::Mutex _endpoints_mutex;
     mutable XPlat::Monitor _shutdown_sync;
     mutable XPlat::Monitor _network_sync;
+    mutable XPlat::Mutex _io_engine_mutex;
+    mutable XPlat::Mutex _filter_executor_mutex;
 
     // Pointer to performance data class (this is requried since performance
     // data includes cannot be included in this header)
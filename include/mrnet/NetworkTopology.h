@@ -158,6 +158,9 @@ class NetworkTopology: public Error {
 
     //Access topology components
     bool node_Failed( Rank irank ) const ;
+    /* changes whenever nodes are removed from the topology, so callers
+       caching node_Failed() results know when to check again */
+    unsigned int get_RemovalEpoch(void) const;
     PeerNodePtr get_OutletNode( Rank irank ) const;
     std::string get_TopologyString(void);
     std::string get_LocalSubTreeString(void);
@@ -218,6 +221,7 @@ class NetworkTopology: public Error {
     mutable XPlat::Monitor _sync;
     SerialGraph *_serial_graph;
     std::vector< update_contents* > _updates_buffer;
+    unsigned int _removal_epoch;
 
     void find_PotentialAdopters( Node * iadoptee,
                                  Node * ipotential_adopter,
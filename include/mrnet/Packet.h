@@ -10,11 +10,13 @@
 
 #include <cstdarg>
 #include <set>
+#include <utility>
 #include <vector>
 
 #include <boost/shared_ptr.hpp>
 #include "mrnet/DataElement.h"
 #include "mrnet/Error.h"
+#include "mrnet/TypedPacket.h"
 #include "xplat/Mutex.h"
 
 struct PDR;
@@ -22,8 +24,12 @@ namespace MRN
 {
 class Timer;
 class Packet;
+class FormatDescriptor;
 typedef boost::shared_ptr< Packet > PacketPtr;
 
+// called once an external data packet no longer references caller memory
+typedef void (*PacketDoneFunc)( void * iarg );
+
 class Packet: public Error {
 
     friend class ParentNode;
@@ -31,6 +37,7 @@ class Packet: public Error {
     friend class Stream;
     friend class Message;
     friend class Network;
+    friend class FragmentAssembler;
 
  public:
 
@@ -42,15 +49,37 @@ class Packet: public Error {
     Packet( const char *ifmt, va_list idata, unsigned int istream_id, int itag );
     Packet( unsigned int istream_id, int itag, const void **idata, const char *ifmt );
 
+    // encodes the inum_args values of iargs, which must match the fields
+    // of ifmt, directly into the packet buffer (see TypedPacket.h)
+    Packet( unsigned int istream_id, int itag, const char *ifmt,
+            const TypedArg *iargs, size_t inum_args );
+
+    // external data packets send large scalar and byte arrays directly
+    // from the caller's memory instead of copying them into the packet
+    // buffer. The arrays must stay valid and unmodified until idone(iarg)
+    // is called, which happens exactly once, when the packet is destroyed.
+    // For a packet that the caller releases after Stream::send(), that is
+    // after it has been written to every destination child (or dropped).
+    Packet( unsigned int istream_id, int itag,
+            PacketDoneFunc idone, void *iarg, const char *ifmt, ... );
+    Packet( PacketDoneFunc idone, void *iarg, const char *ifmt,
+            va_list idata, unsigned int istream_id, int itag );
+
     int unpack( const char *ifmt, ... );
     int unpack( va_list iarg_list, const char* ifmt, bool );
+#if defined(MRNET_TYPED_API)
+    // type-checked unpack into odata, fails unless the packet's format
+    // string is the one generated for the types of odata
+    template< typename... Ts > int unpack_typed( Ts &... odata ) const;
+#endif
     const DataElement* operator[]( unsigned int i ) const;
 
     int get_Tag(void) const;
-    void set_Tag( int itag ) { tag = itag; }
+    void set_Tag( int itag ) { tag = itag; _send_lane = SEND_LANE_UNKNOWN; }
 
     unsigned int get_StreamId(void) const;
-    void set_StreamId( unsigned int istream_id ) { stream_id = istream_id; }
+    void set_StreamId( unsigned int istream_id )
+    { stream_id = istream_id; _send_lane = SEND_LANE_UNKNOWN; }
 
     const char* get_FormatString(void) const;
     Rank get_InletNodeRank(void) const;
@@ -64,10 +93,16 @@ class Packet: public Error {
 
     void set_DestroyData( bool b );
 
+    // decode arrays of received packets in place (default), rather than
+    // copying them out of the packet buffer
+    void set_ZeroCopyDecode( bool b );
+
     // END MRNET API
 
 
     // Only use these if you **really** know what you are doing!!
+    // (the buffer of an external data packet lacks its external arrays,
+    // which are included in the buffer length)
     const char *get_Buffer(void) const;
     uint64_t get_BufferLen(void) const;
     const char *get_Header(void) const;
@@ -87,6 +122,10 @@ class Packet: public Error {
     void set_IncomingPktCount(int size);
     void set_OutgoingPktCount(int size);
 
+    // Packet objects are recycled through a process-wide pool
+    static void * operator new( size_t sz );
+    static void operator delete( void * p, size_t sz );
+
     ~Packet();
 
  private:
@@ -98,8 +137,14 @@ class Packet: public Error {
     Packet( unsigned int ihdr_len, char *ihdr, 
             uint64_t ibuf_len, char *ibuf, 
             Rank iinlet_rank );
+    Packet( uint32_t istream_id, int32_t itag, Rank isrc,
+            const FormatDescriptor *ifmt_desc,
+            Rank *idest_arr, uint64_t idest_arr_len, char ibyteorder,
+            uint64_t ibuf_len, char *ibuf, Rank iinlet_rank,
+            bool ipooled_buf );
     void encode_pdr_header(void);
     void encode_pdr_data(void);
+    void encode_typed_data( const TypedArg *iargs, size_t inum_args );
     void decode_pdr_header(void) const;
     void decode_pdr_data(void) const;
 
@@ -108,6 +153,38 @@ class Packet: public Error {
     size_t get_NumDataElements(void) const;
     const DataElement * get_DataElement( unsigned int i ) const;
 
+    void set_FormatString( const char * ifmt );
+    const FormatDescriptor * get_FormatDescriptor(void) const;
+
+    /* arrays of an external data packet that are sent from caller memory,
+       each following the first 'offset' bytes of buf */
+    struct ExternalSegment {
+        uint64_t offset;
+        const char * data;
+        uint64_t len;
+    };
+    struct ExternalData {
+        PacketDoneFunc done;
+        void * done_arg;
+        uint64_t len;       /* sum of segment lengths */
+        std::vector< ExternalSegment > segments;
+    };
+
+    /* arrays smaller than this are still copied into buf */
+    static const uint64_t external_min_len = 4096;
+
+    void init_ExternalData( PacketDoneFunc idone, void * iarg );
+    const ExternalData * get_ExternalData(void) const { return _ext; }
+    bool is_ExternalElement( size_t i ) const;
+    int pdr_external_array( struct PDR * pdrs, size_t i );
+
+    /* the encoded payload as (address, length) pieces, which is buf
+       interleaved with the external arrays of external data packets */
+    void get_PayloadSegments( std::vector< std::pair< const char *, uint64_t > > & osegs ) const;
+
+    void alloc_DataElements( size_t num );
+    void free_DataElements(void);
+
     int ExtractVaList( const char *fmt, va_list arg_list ) const;
     int ArgList2DataElementArray( va_list arg_list );
     int DataElementArray2ArgList( va_list arg_list ) const;
@@ -121,29 +198,61 @@ class Packet: public Error {
     uint32_t stream_id;
     int32_t tag;            /* Application/Protocol Level ID */
     Rank src_rank;          /* Null Terminated String */
-    char *fmt_str;          /* Null Terminated String */
+    const char *fmt_str;    /* interned, owned by _fmt_desc */
+    const FormatDescriptor * _fmt_desc; /* compiled fmt_str */
     
     char *hdr;              /* packed header */
     unsigned int hdr_len;
 
     char *buf;              /* packed data */
     uint64_t buf_len;
+    bool _pooled_buf;       /* buf came from the receive BufferPool */
+    ExternalData * _ext;    /* NULL unless an external data packet */
 
     Rank inlet_rank;
     Rank *dest_arr;
     uint64_t dest_arr_len;
     bool destroy_data;
 
-    std::vector< const DataElement * > data_elements;
+    /* elements live in _inline_elements for formats with few fields,
+       otherwise in an array from the packet pool */
+    static const unsigned int num_inline_elements = 4;
+    DataElement * _elements;
+    size_t _num_elements;
+    size_t _max_elements;
+    DataElement _inline_elements[ num_inline_elements ];
     mutable XPlat::Mutex data_sync;
 
-    Timer * _perf_data_timer;
+    Timer * _perf_data_timer;   /* allocated on first use */
     int _in_packet_count;
     int _out_packet_count;
     mutable bool _decoded;
     mutable char _byteorder;
+    bool _zero_copy_decode;
+
+    /* send queue lane, set by the first Message that queues the packet
+       (see Message::is_PriorityPacket) */
+    enum { SEND_LANE_UNKNOWN, SEND_LANE_NORMAL, SEND_LANE_PRIORITY };
+    mutable char _send_lane;
 };
 
+#if defined(MRNET_TYPED_API)
+
+template< typename... Ts >
+int Packet::unpack_typed( Ts &... odata ) const
+{
+    if( strcmp(TypedFormat< Ts... >::get(), get_FormatString()) != 0 )
+        return -1;
+
+    unsigned int i = 0;
+    bool ok = true;
+    bool results[] = { true, ( ok = ok && TypedField< Ts >::get((*this)[i++], odata) )... };
+    (void)results;
+
+    return ( ok ? 0 : -1 );
+}
+
+#endif /* MRNET_TYPED_API */
 
 }                               /* namespace MRN */
 #endif                          /* packet_h */
@@ -0,0 +1,97 @@
+/****************************************************************************
+ *  Copyright 2003-2015 Dorian C. Arnold, Philip C. Roth, Barton P. Miller  *
+ *                  Detailed MRNet usage rights in "LICENSE" file.          *
+ ****************************************************************************/
+
+#if !defined(__quantilesketch_h)
+#define __quantilesketch_h 1
+
+#include <vector>
+
+#include "mrnet/Packet.h"
+#include "mrnet/Types.h"
+
+namespace MRN
+{
+
+class Stream;
+
+/*
+ * Mergeable quantile sketch (DDSketch) of non-negative samples, e.g.
+ * latencies, aggregated by the TFILTER_QUANTILE_SKETCH filter.
+ *
+ * Samples are counted in logarithmically sized buckets, so any quantile is
+ * estimated within a relative error of 'relative_accuracy' (default 1%).
+ * At most 'max_buckets' buckets are kept (8 bytes each on the wire); when
+ * samples span more than that, the lowest buckets are merged, so only the
+ * smallest quantiles lose accuracy. With the defaults, samples spanning 17
+ * orders of magnitude fit.
+ *
+ * Back-ends add() samples and send() the sketch. Each parent merges the
+ * sketches of a wave into one of at most 'max_buckets' buckets, and the
+ * front-end calls unpack() on the received packet and get_Quantile().
+ *
+ * Zero and negative samples are counted as 0. NaN and infinite samples are
+ * ignored. Sketches with different relative accuracies cannot be merged.
+ */
+class QuantileSketch {
+
+ public:
+
+    // BEGIN MRNET API
+
+    QuantileSketch( double irelative_accuracy=0.01,
+                    unsigned int imax_buckets=2048 );
+
+    void add( double ivalue, uint64_t icount=1 );
+    void clear(void);
+
+    /* returns -1 if the relative accuracies differ */
+    int merge( const QuantileSketch & isketch );
+    int merge( const PacketPtr & ipacket );
+
+    /* replaces this sketch by the one in 'ipacket', including its
+       accuracy and bucket limit. Returns -1 if it holds no sketch */
+    int unpack( const PacketPtr & ipacket );
+
+    int send( Stream * istrm, int itag ) const;
+    PacketPtr get_Packet( unsigned int istream_id, int itag ) const;
+
+    /* 0 <= iq <= 1, returns 0 for an empty sketch */
+    double get_Quantile( double iq ) const;
+
+    uint64_t get_Count(void) const { return _count; }
+    double get_Min(void) const { return _min; }
+    double get_Max(void) const { return _max; }
+    double get_Sum(void) const { return _sum; }
+    double get_RelativeAccuracy(void) const { return _relative_accuracy; }
+    unsigned int get_MaxBuckets(void) const { return _max_buckets; }
+
+    // END MRNET API
+
+ private:
+
+    void set_Accuracy( double irelative_accuracy, unsigned int imax_buckets );
+    int get_Key( double ivalue ) const;
+    double get_Value( int ikey ) const;
+    void extend_Range( int ilow, int ihigh );
+    void merge_Counts( int ioffset, const uint64_t * icounts, uint64_t ilen,
+                       uint64_t izero_count, double imin, double imax,
+                       double isum );
+
+    double _relative_accuracy;
+    double _gamma, _log_gamma;
+    unsigned int _max_buckets;
+
+    /* _counts[i] is the count of bucket _offset + i, holding samples in
+       (gamma^(key-1), gamma^key] */
+    std::vector< uint64_t > _counts;
+    int _offset;
+
+    uint64_t _zero_count, _count;
+    double _min, _max, _sum;
+};
+
+} // namespace MRN
+
+#endif /* __quantilesketch_h */
@@ -24,6 +24,7 @@ class Filter;
 class FrontEndNode;
 class BackEndNode;
 class PerfDataMgr;
+class WaveAccumulator;
 
 typedef enum {
     FILTER_DOWNSTREAM_TRANS,
@@ -56,11 +57,35 @@ class Stream {
     int send( const char *idata_fmt, va_list idata, int itag );
     int send( int itag, const void **idata, const char *iformat_str );
     int send( PacketPtr& ipacket );
+    // sends large arrays from the caller's memory without copying them,
+    // idone(iarg) is called once they are no longer needed (see Packet.h)
+    int send_external( int itag, PacketDoneFunc idone, void *iarg,
+                       const char *iformat_str, ... );
+#if defined(MRNET_TYPED_API)
+    // sends idata with a format generated from its types, for example
+    // send_typed< int32_t, std::vector<double> >( tag, i, v ) sends "%d %alf"
+    template< typename... Ts > int send_typed( int itag, const Ts &... idata );
+#endif
     int flush(void) const;
     int recv( int *otag, PacketPtr &opacket, bool iblocking = true );
 
+    /* By default, send() waits while a peer send queue is full. In
+       non-blocking mode, send() instead fails with the network error
+       ERR_WOULDBLOCK and the packet is not sent. */
+    void set_BlockingSend( bool iblocking );
+    bool is_BlockingSend(void) const;
+
+    /* occupancy and high-water marks of the received packet queue */
+    void get_QueueStats( queue_stats_t & ostats ) const;
+
+    /* queue depth and filter CPU time of this stream on the local filter
+       executor (see MRNET_FILTER_THREADS). Returns -1 if the stream's
+       filters run inline on this node */
+    int get_FilterStats( filter_stats_t & ostats ) const;
+
     const std::set< Rank > & get_EndPoints(void) const;
     unsigned int get_Id(void) const;
+    stream_priority_t get_Priority(void) const;
     unsigned int size(void) const;
     bool has_Data(void);
 
@@ -98,9 +123,12 @@ class Stream {
 
     void close(void);
     void get_ChildRanks( std::set< Rank >& ) const;
+    /* changes whenever the set of child peers changes */
+    unsigned int get_ChildPeersEpoch(void) const;
     void get_ChildPeers( std::set< PeerNodePtr >& ) const;
     void add_Stream_EndPoint( Rank irank );
     void add_Stream_Peer( Rank irank );
+    void set_Priority( stream_priority_t ipriority );
 
     PacketPtr collect_PerfData( perfdata_metric_t metric, 
                                 perfdata_context_t context, 
@@ -123,6 +151,14 @@ class Stream {
     PacketPtr get_IncomingPacket(void);
     int push_Packet( PacketPtr, std::vector<PacketPtr> &, std::vector<PacketPtr> &, 
                      bool upstream );
+    int push_Packets( std::vector<PacketPtr> &, std::vector<PacketPtr> &,
+                      std::vector<PacketPtr> &, bool upstream );
+    int push_Waves( std::vector<PacketPtr> &, std::vector<PacketPtr> &,
+                    std::vector<PacketPtr> &, const TopologyLocalInfo & );
+    void update_SyncFilterPerfData( double secs );
+    void begin_TransFilterPerfData( size_t num_in, long & user, long & sys );
+    void end_TransFilterPerfData( double secs, size_t num_out,
+                                  long user_before, long sys_before );
 
     int send_FilterStateToParent(void) const;
     PacketPtr get_FilterState(void) const;
@@ -138,33 +174,51 @@ class Stream {
     bool close_Peer( Rank irank );
     void signal_BlockedReceivers(void) const;
     int block_ForIncomingPacket(void) const;
+    bool would_BlockSend( bool upstream );
 
     //Static Data Members
     PerfDataMgr * _perf_data;
     Network * _network;
     unsigned int _id;
+    stream_priority_t _priority;
     unsigned int _sync_filter_id;
     Filter * _sync_filter;
     unsigned int _us_filter_id;
     Filter * _us_filter;
     unsigned int _ds_filter_id;
     Filter * _ds_filter;
+    WaveAccumulator * _wave_acc; // SFILTER_INCREMENTAL, if the filter allows
     std::set< Rank > _end_points;
 
     //Dynamic Data Members
     EventPipe * _evt_pipe;
     bool _was_closed;
     int _num_sending;
+    bool _blocking_send;
     std::set< PeerNodePtr > _peers; // child peers in stream
+    unsigned int _peers_epoch;
     mutable XPlat::Mutex _peers_sync;
     mutable XPlat::Monitor _send_sync;
 
     std::list< PacketPtr > _incoming_packet_buffer;
+    uint64_t _incoming_bytes, _incoming_peak_packets, _incoming_peak_bytes;
     mutable XPlat::Monitor _incoming_packet_buffer_sync;
 
     enum {PACKET_BUFFER_NONEMPTY, STREAM_SEND_EMPTY};
 };
 
+#if defined(MRNET_TYPED_API)
+
+template< typename... Ts >
+int Stream::send_typed( int itag, const Ts &... idata )
+{
+    TypedArg args[] = { TypedField< Ts >::arg( idata )..., TypedArg() };
+    PacketPtr packet( new Packet(_id, itag, TypedFormat< Ts... >::get(),
+                                 args, sizeof...(Ts)) );
+    return send( packet );
+}
+
+#endif /* MRNET_TYPED_API */
 
 } // namespace MRN
 
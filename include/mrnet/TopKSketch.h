@@ -0,0 +1,102 @@
+/****************************************************************************
+ *  Copyright 2003-2015 Dorian C. Arnold, Philip C. Roth, Barton P. Miller  *
+ *                  Detailed MRNet usage rights in "LICENSE" file.          *
+ ****************************************************************************/
+
+#if !defined(__topksketch_h)
+#define __topksketch_h 1
+
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "mrnet/Packet.h"
+#include "mrnet/Types.h"
+
+namespace MRN
+{
+
+class Stream;
+
+/*
+ * Mergeable heavy-hitter sketch of 64-bit keys (e.g. hashed call sites or
+ * error codes), aggregated by the TFILTER_TOP_K filter.
+ *
+ * Counts are kept in a count-min sketch of 'depth' rows of 'width'
+ * counters, which never underestimates a key's count and overestimates it
+ * by at most e * total / width with probability 1 - e^-depth. Next to it,
+ * the sketch keeps the 'k' keys with the largest estimates as candidates.
+ *
+ * Back-ends add() keys and send() the sketch. Each parent sums the counters
+ * of a wave, estimates the union of the candidates and keeps the top 'k',
+ * so every packet holds width * depth counters and at most 'k' keys.
+ * The front-end calls unpack() on the received packet and get_TopK().
+ *
+ * The filter parameters set_FilterParameters( FILTER_UPSTREAM_TRANS,
+ * "%ud %ud %ud", k, width, depth ) make the filter send a smaller sketch
+ * than the back-ends: 'width' must divide the back-ends' width and 'depth'
+ * be at most theirs.
+ */
+class TopKSketch {
+
+ public:
+
+    // BEGIN MRNET API
+
+    TopKSketch( unsigned int ik=16, unsigned int iwidth=1024,
+                unsigned int idepth=4 );
+
+    void add( uint64_t ikey, uint64_t icount=1 );
+    void clear(void);
+
+    /* returns -1 if the other sketch cannot be folded into this one, i.e.
+       its width is not a multiple of this width or it has fewer rows */
+    int merge( const TopKSketch & isketch );
+    int merge( const PacketPtr & ipacket );
+
+    /* replaces this sketch by the one in 'ipacket', including its
+       dimensions. Returns -1 if it holds no sketch */
+    int unpack( const PacketPtr & ipacket );
+
+    int send( Stream * istrm, int itag ) const;
+    PacketPtr get_Packet( unsigned int istream_id, int itag ) const;
+
+    /* the top 'k' candidates as (key, estimated count), largest first */
+    void get_TopK( std::vector< std::pair< uint64_t, uint64_t > > & oitems ) const;
+
+    /* never less than the count of 'ikey' */
+    uint64_t get_Estimate( uint64_t ikey ) const;
+
+    uint64_t get_Total(void) const { return _total; }
+    unsigned int get_K(void) const { return _k; }
+    unsigned int get_Width(void) const { return _width; }
+    unsigned int get_Depth(void) const { return _depth; }
+
+    // END MRNET API
+
+ private:
+
+    void set_Dimensions( unsigned int ik, unsigned int iwidth,
+                         unsigned int idepth );
+    void merge_Counters( const uint64_t * icounters, unsigned int iwidth,
+                         unsigned int idepth );
+    void add_Candidate( uint64_t ikey, uint64_t iestimate );
+    void evict_Candidates( size_t imax );
+
+    unsigned int _k, _width, _depth;
+
+    /* row r is _counters[r * _width, (r + 1) * _width) */
+    std::vector< uint64_t > _counters;
+    uint64_t _total;
+
+    /* candidate keys and their estimates when last updated, which are
+       lower bounds of their current ones. _heap orders the same entries
+       by estimate, smallest first */
+    std::map< uint64_t, uint64_t > _candidates;
+    std::set< std::pair< uint64_t, uint64_t > > _heap;
+};
+
+} // namespace MRN
+
+#endif /* __topksketch_h */
@@ -0,0 +1,194 @@
+/****************************************************************************
+ *  Copyright 2003-2015 Dorian C. Arnold, Philip C. Roth, Barton P. Miller  *
+ *                  Detailed MRNet usage rights in "LICENSE" file.          *
+ ****************************************************************************/
+
+#if !defined(__typedpacket_h)
+#define __typedpacket_h 1
+
+/*
+ * Support for the type-checked packet API, Stream::send_typed() and
+ * Packet::unpack_typed(). The format string of a typed packet is derived
+ * from the C++ types of its values, using the same format specifiers as
+ * the printf-style API (e.g., int32_t is "%d", std::vector<double> is
+ * "%alf"), so typed packets can be unpacked with format strings by any
+ * other node, including lightweight back-ends, and vice versa.
+ *
+ * Supported types are char, unsigned char, [u]int{16,32,64}_t, float,
+ * double, std::string and const char*, plus std::vector of any of those
+ * except const char*. Using any other type is a compile-time error.
+ */
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "mrnet/DataElement.h"
+#include "mrnet/Types.h"
+
+#if (__cplusplus >= 201103L) || (defined(_MSC_VER) && (_MSC_VER >= 1800))
+#  define MRNET_TYPED_API 1
+#endif
+
+namespace MRN
+{
+
+/* one value of a typed packet, as passed to the typed Packet constructor */
+struct TypedArg {
+
+    const void * data;      /* value, string, or first array element */
+    uint64_t len;           /* array length */
+    bool std_strings;       /* data is a std::vector< std::string > */
+
+    TypedArg( void )
+        : data(NULL), len(0), std_strings(false) { }
+    TypedArg( const void * idata, uint64_t ilen=0, bool istd_strings=false )
+        : data(idata), len(ilen), std_strings(istd_strings) { }
+};
+
+/* per-type format specifier, argument conversion and extraction. Only
+   the specializations below are defined */
+template< typename T > struct TypedField;
+
+#define MRN_TYPED_SCALAR( T, FMT, DTYPE, GETTER )                       \
+template<> struct TypedField< T > {                                     \
+    static const char * format(void) { return "%" FMT; }                \
+    static const char * array_format(void) { return "%a" FMT; }         \
+    static DataType array_type(void) { return DTYPE##_ARRAY_T; }        \
+    static TypedArg arg( const T & v ) { return TypedArg( &v ); }       \
+    static bool get( const DataElement * e, T & v )                     \
+    {                                                                   \
+        if( (e == NULL) || (e->get_Type() != DTYPE##_T) )               \
+            return false;                                               \
+        v = e->GETTER();                                                \
+        return true;                                                    \
+    }                                                                   \
+};
+
+MRN_TYPED_SCALAR( char,          "c",   CHAR,   get_char )
+MRN_TYPED_SCALAR( unsigned char, "uc",  UCHAR,  get_uchar )
+MRN_TYPED_SCALAR( int16_t,       "hd",  INT16,  get_int16_t )
+MRN_TYPED_SCALAR( uint16_t,      "uhd", UINT16, get_uint16_t )
+MRN_TYPED_SCALAR( int32_t,       "d",   INT32,  get_int32_t )
+MRN_TYPED_SCALAR( uint32_t,      "ud",  UINT32, get_uint32_t )
+MRN_TYPED_SCALAR( int64_t,       "ld",  INT64,  get_int64_t )
+MRN_TYPED_SCALAR( uint64_t,      "uld", UINT64, get_uint64_t )
+MRN_TYPED_SCALAR( float,         "f",   FLOAT,  get_float )
+MRN_TYPED_SCALAR( double,        "lf",  DOUBLE, get_double )
+
+#undef MRN_TYPED_SCALAR
+
+template<> struct TypedField< std::string > {
+    static const char * format(void) { return "%s"; }
+    static const char * array_format(void) { return "%as"; }
+    static DataType array_type(void) { return STRING_ARRAY_T; }
+    static TypedArg arg( const std::string & v ) { return TypedArg( v.c_str() ); }
+    static bool get( const DataElement * e, std::string & v )
+    {
+        if( (e == NULL) || (e->get_Type() != STRING_T) ||
+            (e->get_string() == NULL) )
+            return false;
+        v = e->get_string();
+        return true;
+    }
+};
+
+/* unpacked C strings point into the packet, and are only valid while
+   the packet exists */
+template<> struct TypedField< const char * > {
+    static const char * format(void) { return "%s"; }
+    static TypedArg arg( const char * v ) { return TypedArg( v ); }
+    static bool get( const DataElement * e, const char *& v )
+    {
+        if( (e == NULL) || (e->get_Type() != STRING_T) )
+            return false;
+        v = e->get_string();
+        return true;
+    }
+};
+
+template<> struct TypedField< char * > {
+    static const char * format(void) { return "%s"; }
+    static TypedArg arg( const char * v ) { return TypedArg( v ); }
+};
+
+template< size_t N > struct TypedField< char[N] > {
+    static const char * format(void) { return "%s"; }
+    static TypedArg arg( const char * v ) { return TypedArg( v ); }
+};
+
+template< typename T > struct TypedField< std::vector< T > > {
+    static const char * format(void) { return TypedField< T >::array_format(); }
+    static TypedArg arg( const std::vector< T > & v )
+    {
+        return TypedArg( v.empty() ? NULL : &v[0], v.size() );
+    }
+    static bool get( const DataElement * e, std::vector< T > & v )
+    {
+        DataType t;
+        uint64_t len;
+        if( e == NULL )
+            return false;
+        const T * arr = (const T *) e->get_array( &t, &len );
+        if( t != TypedField< T >::array_type() )
+            return false;
+        if( len && (arr == NULL) )
+            return false;
+        v.assign( arr, arr + len );
+        return true;
+    }
+};
+
+template<> struct TypedField< std::vector< std::string > > {
+    static const char * format(void) { return "%as"; }
+    static TypedArg arg( const std::vector< std::string > & v )
+    {
+        return TypedArg( &v, v.size(), true );
+    }
+    static bool get( const DataElement * e, std::vector< std::string > & v )
+    {
+        DataType t;
+        uint64_t len;
+        if( e == NULL )
+            return false;
+        const char * const * arr = (const char * const *) e->get_array( &t, &len );
+        if( (t != STRING_ARRAY_T) || (len && (arr == NULL)) )
+            return false;
+        v.clear();
+        v.reserve( size_t(len) );
+        for( uint64_t i = 0; i < len; i++ )
+            v.push_back( std::string(arr[i] != NULL ? arr[i] : "") );
+        return true;
+    }
+};
+
+#if defined(MRNET_TYPED_API)
+
+/* format string for a list of value types. It is built on first use
+   and shared by every packet with the same types */
+template< typename... Ts > struct TypedFormat {
+    static const char * get(void)
+    {
+        static const std::string fmt = build();
+        return fmt.c_str();
+    }
+
+ private:
+    static std::string build(void)
+    {
+        std::string ret;
+        const char * tokens[] = { TypedField< Ts >::format()..., NULL };
+        for( unsigned int i = 0; tokens[i] != NULL; i++ ) {
+            if( i )
+                ret += ' ';
+            ret += tokens[i];
+        }
+        return ret;
+    }
+};
+
+#endif /* MRNET_TYPED_API */
+
+} /* namespace MRN */
+
+#endif /* __typedpacket_h */
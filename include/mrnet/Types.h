@@ -143,9 +143,41 @@ namespace MRN
         XPLAT_REMCMD,             /* 10 */
         CRAY_ALPS_APID,
         CRAY_ALPS_APRUN_PID,
-        CRAY_ALPS_STAGE_FILES
+        CRAY_ALPS_STAGE_FILES,
+        MRNET_SEND_COALESCE_USEC,
+        MRNET_SEND_COALESCE_BYTES,  /* 15 */
+        MRNET_SEND_COALESCE_PACKETS,
+        MRNET_IO_ENGINE,
+        MRNET_IO_ENGINE_WORKERS,
+        MRNET_SEND_QUEUE_MAX_PACKETS,
+        MRNET_SEND_QUEUE_MAX_BYTES, /* 20 */
+        MRNET_SEND_FRAGMENT_BYTES,
+        MRNET_FILTER_THREADS
     } net_settings_key_t;   
 
+    /* stream send priority: packets of high priority streams are sent
+       ahead of queued normal priority packets on each link */
+    typedef enum {
+        STREAM_PRIORITY_NORMAL = 0,
+        STREAM_PRIORITY_HIGH
+    } stream_priority_t;
+
+    /* packet queue occupancy, and its high-water marks */
+    typedef struct {
+        uint64_t num_packets;
+        uint64_t num_bytes;
+        uint64_t max_packets;
+        uint64_t max_bytes;
+    } queue_stats_t;
+
+    /* filter executor activity of a stream on the local node */
+    typedef struct {
+        uint64_t num_packets;       /* packets waiting to be filtered */
+        uint64_t max_packets;       /* high-water mark of num_packets */
+        uint64_t num_batches;       /* batches filtered so far */
+        uint64_t filter_usec;       /* filter thread CPU time */
+    } filter_stats_t;
+
 } /* namespace MRN */
 
 #endif /* MRNET_TYPES_H */
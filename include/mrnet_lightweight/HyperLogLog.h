@@ -0,0 +1,40 @@
+/****************************************************************************
+ *  Copyright 2003-2015 Dorian C. Arnold, Philip C. Roth, Barton P. Miller  *
+ *                  Detailed MRNet usage rights in "LICENSE" file.          *
+ ****************************************************************************/
+
+#if !defined(__hyperloglog_h)
+#define __hyperloglog_h 1
+
+#include <stddef.h>
+
+#include "mrnet_lightweight/Stream.h"
+#include "mrnet_lightweight/Types.h"
+
+/*
+ * Back-end side of the TFILTER_HYPERLOGLOG filter: a HyperLogLog sketch of
+ * distinct identifiers, hashed and sent the same way as by the
+ * MRN::HyperLogLog class of the full library. See that class for the
+ * meaning of the precision (4 to 18, 12 in C++ by default).
+ */
+typedef struct {
+    unsigned int precision;
+    unsigned char* registers;   /* 2^precision of them */
+} HyperLogLog_t;
+
+/* BEGIN PUBLIC API */
+
+HyperLogLog_t* new_HyperLogLog_t(unsigned int iprecision);
+void delete_HyperLogLog_t(HyperLogLog_t* sketch);
+
+void HyperLogLog_add(HyperLogLog_t* sketch, const void* idata, size_t ilen);
+void HyperLogLog_add_String(HyperLogLog_t* sketch, const char* istr);
+void HyperLogLog_add_Value(HyperLogLog_t* sketch, uint64_t ivalue);
+void HyperLogLog_add_Hash(HyperLogLog_t* sketch, uint64_t ihash);
+void HyperLogLog_clear(HyperLogLog_t* sketch);
+
+int HyperLogLog_send(HyperLogLog_t* sketch, Stream_t* stream, int itag);
+
+/* END PUBLIC API */
+
+#endif /* __hyperloglog_h */
@@ -10,9 +10,12 @@
 
 #include "mrnet_lightweight/DataElement.h"
 #include "mrnet_lightweight/Error.h"
+#include "mrnet_lightweight/HyperLogLog.h"
 #include "mrnet_lightweight/Network.h"
 #include "mrnet_lightweight/NetworkTopology.h"
 #include "mrnet_lightweight/Packet.h"
+#include "mrnet_lightweight/QuantileSketch.h"
 #include "mrnet_lightweight/Stream.h"
+#include "mrnet_lightweight/TopKSketch.h"
 
 #endif /* mrnet_lightweight_h */
@@ -59,6 +59,11 @@ Packet_t* new_Packet_t_3(unsigned int ihdr_len, char* ihdr,
                          uint64_t ibuf_len, char* ibuf, 
                          Rank iinlet_rank);
 
+Packet_t* new_Packet_t_4(uint32_t istream_id, int32_t itag, Rank isrc,
+                         char* ifmt_str, char ibyteorder,
+                         uint64_t ibuf_len, char* ibuf,
+                         Rank iinlet_rank);
+
 void Packet_pushBackElement(Packet_t* packet, DataElement_t* cur_elem);
 
 int Packet_ExtractVaList(Packet_t* packet, const char* fmt, va_list arg_list);
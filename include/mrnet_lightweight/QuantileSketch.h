@@ -0,0 +1,45 @@
+/****************************************************************************
+ *  Copyright 2003-2015 Dorian C. Arnold, Philip C. Roth, Barton P. Miller  *
+ *                  Detailed MRNet usage rights in "LICENSE" file.          *
+ ****************************************************************************/
+
+#if !defined(__quantilesketch_h)
+#define __quantilesketch_h 1
+
+#include "mrnet_lightweight/Stream.h"
+#include "mrnet_lightweight/Types.h"
+
+/*
+ * Back-end side of the TFILTER_QUANTILE_SKETCH filter: a quantile sketch
+ * (DDSketch) of non-negative samples, sent in the same format as the
+ * MRN::QuantileSketch class of the full library. See that class for the
+ * meaning of the relative accuracy and bucket limit (0.01 and 2048 by
+ * default in C++).
+ */
+typedef struct {
+    double relative_accuracy;
+    double log_gamma;
+    unsigned int max_buckets;
+    int offset;                 /* key of counts[0] */
+    uint64_t* counts;
+    uint32_t num_counts;
+    uint64_t zero_count;
+    uint64_t count;
+    double min, max, sum;
+} QuantileSketch_t;
+
+/* BEGIN PUBLIC API */
+
+QuantileSketch_t* new_QuantileSketch_t(double irelative_accuracy,
+                                       unsigned int imax_buckets);
+void delete_QuantileSketch_t(QuantileSketch_t* sketch);
+
+/* zero and negative samples count as 0, NaN and infinite ones are ignored */
+void QuantileSketch_add(QuantileSketch_t* sketch, double ivalue, uint64_t icount);
+void QuantileSketch_clear(QuantileSketch_t* sketch);
+
+int QuantileSketch_send(QuantileSketch_t* sketch, Stream_t* stream, int itag);
+
+/* END PUBLIC API */
+
+#endif /* __quantilesketch_h */
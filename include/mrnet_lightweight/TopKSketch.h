@@ -0,0 +1,44 @@
+/****************************************************************************
+ *  Copyright 2003-2015 Dorian C. Arnold, Philip C. Roth, Barton P. Miller  *
+ *                  Detailed MRNet usage rights in "LICENSE" file.          *
+ ****************************************************************************/
+
+#if !defined(__topksketch_h)
+#define __topksketch_h 1
+
+#include "mrnet_lightweight/Stream.h"
+#include "mrnet_lightweight/Types.h"
+
+/*
+ * Back-end side of the TFILTER_TOP_K filter: a count-min sketch of 64-bit
+ * keys with the k heaviest keys as candidates, sent in the same format as
+ * the MRN::TopKSketch class of the full library. See that class for the
+ * meaning of the dimensions (16, 1024 and 4 by default in C++).
+ */
+typedef struct {
+    uint64_t key;
+    uint64_t estimate;
+} TopKCandidate_t;
+
+typedef struct {
+    unsigned int k, width, depth;
+    uint64_t* counters;         /* row r starts at counters + r * width */
+    uint64_t total;
+    TopKCandidate_t* heap;      /* min-heap on estimate */
+    unsigned int num_candidates;
+} TopKSketch_t;
+
+/* BEGIN PUBLIC API */
+
+TopKSketch_t* new_TopKSketch_t(unsigned int ik, unsigned int iwidth,
+                               unsigned int idepth);
+void delete_TopKSketch_t(TopKSketch_t* sketch);
+
+void TopKSketch_add(TopKSketch_t* sketch, uint64_t ikey, uint64_t icount);
+void TopKSketch_clear(TopKSketch_t* sketch);
+
+int TopKSketch_send(TopKSketch_t* sketch, Stream_t* stream, int itag);
+
+/* END PUBLIC API */
+
+#endif /* __topksketch_h */
@@ -0,0 +1,66 @@
+/****************************************************************************
+ *  Copyright 2003-2015 Dorian C. Arnold, Philip C. Roth, Barton P. Miller  *
+ *                  Detailed MRNet usage rights in "LICENSE" file.          *
+ ****************************************************************************/
+
+#if !defined(__bufferpool_h)
+#define __bufferpool_h 1
+
+#include <cstddef>
+#include <vector>
+
+#include "mrnet/Types.h"
+#include "xplat/Mutex.h"
+
+namespace MRN
+{
+
+/*
+ * Size-class pool for packet header and payload buffers received by
+ * Message::recv(), and for Packet objects themselves. Blocks are obtained
+ * from malloc() and rounded up to a power-of-two class size, so they keep
+ * malloc's alignment guarantee.
+ * Released blocks are cached per class (up to a fixed depth) and handed
+ * out again; requests larger than the largest class always use malloc.
+ */
+class BufferPool {
+
+ public:
+
+    static BufferPool * get_RecvPool(void);
+
+    /* pool for Packet objects and their DataElement arrays */
+    static BufferPool * get_PacketPool(void);
+
+    BufferPool(void);
+    ~BufferPool(void);
+
+    /* get a buffer of at least 'len' bytes */
+    char * alloc( size_t len );
+
+    /* return a buffer previously obtained via alloc(len) */
+    void release( char * buf, size_t len );
+
+    /* allocations satisfied from / not satisfied from the cache */
+    uint64_t get_Hits(void) const;
+    uint64_t get_Misses(void) const;
+
+ private:
+
+    static const unsigned int min_class_shift = 5;   /* 32 bytes */
+    static const unsigned int max_class_shift = 16;  /* 64 KiB */
+    static const unsigned int num_classes = max_class_shift - min_class_shift + 1;
+    static const size_t max_cached_per_class = 256;
+
+    /* returns class index for len, or num_classes if len is too big */
+    static unsigned int get_Class( size_t len );
+
+    std::vector< char * > _free_lists[ num_classes ];
+    uint64_t _hits;
+    uint64_t _misses;
+    mutable XPlat::Mutex _pool_mutex;
+};
+
+} // namespace MRN
+
+#endif /* __bufferpool_h */
@@ -8,6 +8,7 @@
 
 #include <string>
 
+#include "FragmentAssembler.h"
 #include "Message.h"
 #include "PeerNode.h"
 
@@ -30,6 +31,9 @@ class ChildNode: public virtual Error,
     int proc_PacketsFromParent( std::list<PacketPtr> & );
     virtual int proc_DataFromParent( PacketPtr ipacket ) const=0;
 
+    // fragments of large data packets, see Protocol.h
+    int proc_FragmentFromParent( PacketPtr ipacket );
+
     bool ack_ControlProtocol( int ack_tag, bool success ) const;
 
     int proc_RecoveryReport( PacketPtr ipacket ) const;
@@ -68,6 +72,8 @@ class ChildNode: public virtual Error,
  private:
     uint16_t _incarnation; //incremented each time child connects to new parent
 
+    FragmentAssembler _fragments;
+
     mutable XPlat::Mutex _sync;
 };
 
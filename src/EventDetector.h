@@ -58,10 +58,11 @@ class EventDetector {
     
     bool add_FD( XPlat_Socket ifd );
     bool remove_FD( XPlat_Socket ifd );
-    int eventWait( std::set< XPlat_Socket >& event_fds, int timeout,
+    /* timeout_usec of -1 blocks */
+    int eventWait( std::set< XPlat_Socket >& event_fds, int64_t timeout_usec,
                    bool use_poll/*=true*/ );
 
-    void handle_Timeout( TimeKeeper*, int );
+    void handle_Timeout( TimeKeeper* );
 
     void set_ThrId( XPlat::Thread::Id );
 
@@ -43,20 +43,46 @@ class Filter: public Error {
                       std::vector < PacketPtr > &opackets_reverse,
                       const TopologyLocalInfo &info );
 
+    /* runs the filter once per input set, taking the filter lock once
+       for all of them. osets[i] receives the output of isets[i] */
+    int push_PacketSets( std::vector < std::vector < PacketPtr > > &isets,
+                         std::vector < std::vector < PacketPtr > > &osets,
+                         std::vector < PacketPtr > &opackets_reverse,
+                         const TopologyLocalInfo &info );
+
+    /* incremental mode (see SFILTER_INCREMENTAL): folds one packet into
+       the wave at '*wave_data', and emits the result of a wave */
+    bool is_Incremental(void) const;
+    int accumulate_Packet( const PacketPtr & ipacket, void ** wave_data,
+                           const TopologyLocalInfo &info );
+    int finalize_Wave( void ** wave_data,
+                       std::vector < PacketPtr > &opackets,
+                       std::vector < PacketPtr > &opackets_reverse,
+                       const TopologyLocalInfo &info );
+
     PacketPtr get_FilterState( int istream_id );
     void set_FilterParams( PacketPtr iparams );
+    PacketPtr get_FilterParams(void) const;
 
     static int load_FilterFunc( FilterInfoPtr filterInfo, unsigned short iid, const char *so_file, const char *func );
     static bool register_Filter( FilterInfoPtr filterInfo,
                                  unsigned short iid,
                                  void (*ifilter_func)( ),
                                  void (*istate_func)( ),
-                                 const char * ifmt );
+                                 const char * ifmt,
+                                 void (*iaccumulate_func)( ) = NULL,
+                                 void (*ifinalize_func)( ) = NULL );
 
     static void initialize_static_stuff(FilterInfoPtr filterInfo );
  private:
     static void free_static_stuff( );
 
+    void start_Timers( std::vector < PacketPtr > &ipackets,
+                       PerfDataMgr * pdm ) const;
+    void stop_Timers( std::vector < PacketPtr > &ipackets,
+                      std::vector < PacketPtr > &opackets,
+                      PerfDataMgr * pdm ) const;
+
     unsigned short _id;
     void * _filter_state;
     XPlat::Mutex _mutex;
@@ -66,6 +92,11 @@ class Filter: public Error {
                             std::vector < PacketPtr >&, 
                             void **, PacketPtr&, const TopologyLocalInfo& );
     PacketPtr ( *_get_state_func )( void ** ifilter_state, int istream_id );
+    void ( *_accumulate_func )( const PacketPtr&, void **, void **,
+                                PacketPtr&, const TopologyLocalInfo& );
+    void ( *_finalize_func )( void **, std::vector < PacketPtr >&,
+                              std::vector < PacketPtr >&,
+                              void **, PacketPtr&, const TopologyLocalInfo& );
 
     Stream * _strm;
     PacketPtr _params;
@@ -76,16 +107,21 @@ class FilterInfo {
     friend class Filter;
  public:
     FilterInfo(void)
-        : filter_func(NULL), state_func(NULL), filter_fmt(NULL_STRING)
+        : filter_func(NULL), state_func(NULL), filter_fmt(NULL_STRING),
+          accumulate_func(NULL), finalize_func(NULL)
     {
     }
-     FilterInfo( void(*ifilter)(), void(*istate)(), const char* ifmt )
-        : filter_func(ifilter), state_func(istate), filter_fmt(ifmt)
+     FilterInfo( void(*ifilter)(), void(*istate)(), const char* ifmt,
+                 void(*iaccumulate)() = NULL, void(*ifinalize)() = NULL )
+        : filter_func(ifilter), state_func(istate), filter_fmt(ifmt),
+          accumulate_func(iaccumulate), finalize_func(ifinalize)
     {
     }
     FilterInfo( const FilterInfo &finfo )
         : filter_func(finfo.filter_func), state_func(finfo.state_func), 
-          filter_fmt(finfo.filter_fmt)
+          filter_fmt(finfo.filter_fmt),
+          accumulate_func(finfo.accumulate_func),
+          finalize_func(finfo.finalize_func)
     {
     }
     ~FilterInfo(void)
@@ -95,6 +131,8 @@ class FilterInfo {
     void(*filter_func)();
     void(*state_func)();
     std::string filter_fmt;
+    void(*accumulate_func)();
+    void(*finalize_func)();
 };
 
 inline void Filter::initialize_static_stuff( FilterInfoPtr filterInfo)
@@ -107,19 +145,27 @@ inline void Filter::initialize_static_stuff( FilterInfoPtr filterInfo)
 
     TFILTER_SUM = tfilter_start++;
     register_Filter(filterInfo, TFILTER_SUM, 
-                     (void(*)())tfilter_Sum, NULL, TFILTER_SUM_FORMATSTR );
+                     (void(*)())tfilter_Sum, NULL, TFILTER_SUM_FORMATSTR,
+                     (void(*)())tfilter_Sum_accumulate,
+                     (void(*)())tfilter_Sum_finalize );
 
     TFILTER_AVG = tfilter_start++;
     register_Filter(filterInfo, TFILTER_AVG, 
-                     (void(*)())tfilter_Avg, NULL, TFILTER_AVG_FORMATSTR );
+                     (void(*)())tfilter_Avg, NULL, TFILTER_AVG_FORMATSTR,
+                     (void(*)())tfilter_Avg_accumulate,
+                     (void(*)())tfilter_Avg_finalize );
 
     TFILTER_MAX = tfilter_start++;
     register_Filter(filterInfo, TFILTER_MAX, 
-                     (void(*)())tfilter_Max, NULL, TFILTER_MAX_FORMATSTR );
+                     (void(*)())tfilter_Max, NULL, TFILTER_MAX_FORMATSTR,
+                     (void(*)())tfilter_Max_accumulate,
+                     (void(*)())tfilter_Max_finalize );
 
     TFILTER_MIN = tfilter_start++;
     register_Filter(filterInfo, TFILTER_MIN, 
-                     (void(*)())tfilter_Min, NULL, TFILTER_MIN_FORMATSTR );
+                     (void(*)())tfilter_Min, NULL, TFILTER_MIN_FORMATSTR,
+                     (void(*)())tfilter_Min_accumulate,
+                     (void(*)())tfilter_Min_finalize );
 
     TFILTER_ARRAY_CONCAT = tfilter_start++;
     register_Filter(filterInfo, TFILTER_ARRAY_CONCAT, 
@@ -144,6 +190,62 @@ inline void Filter::initialize_static_stuff( FilterInfoPtr filterInfo)
                      (void(*)())tfilter_PerfData, NULL,
                      TFILTER_PERFDATA_FORMATSTR );
 
+    TFILTER_ARRAY_SUM = tfilter_start++;
+    register_Filter(filterInfo, TFILTER_ARRAY_SUM, 
+                     (void(*)())tfilter_ArraySum, NULL, TFILTER_ARRAY_SUM_FORMATSTR,
+                     (void(*)())tfilter_ArraySum_accumulate,
+                     (void(*)())tfilter_ArraySum_finalize );
+
+    TFILTER_ARRAY_MIN = tfilter_start++;
+    register_Filter(filterInfo, TFILTER_ARRAY_MIN, 
+                     (void(*)())tfilter_ArrayMin, NULL, TFILTER_ARRAY_MIN_FORMATSTR,
+                     (void(*)())tfilter_ArrayMin_accumulate,
+                     (void(*)())tfilter_ArrayMin_finalize );
+
+    TFILTER_ARRAY_MAX = tfilter_start++;
+    register_Filter(filterInfo, TFILTER_ARRAY_MAX, 
+                     (void(*)())tfilter_ArrayMax, NULL, TFILTER_ARRAY_MAX_FORMATSTR,
+                     (void(*)())tfilter_ArrayMax_accumulate,
+                     (void(*)())tfilter_ArrayMax_finalize );
+
+    TFILTER_ARRAY_AVG = tfilter_start++;
+    register_Filter(filterInfo, TFILTER_ARRAY_AVG, 
+                     (void(*)())tfilter_ArrayAvg, NULL, TFILTER_ARRAY_AVG_FORMATSTR,
+                     (void(*)())tfilter_ArrayAvg_accumulate,
+                     (void(*)())tfilter_ArrayAvg_finalize );
+
+    TFILTER_FIELD_REDUCE = tfilter_start++;
+    register_Filter(filterInfo, TFILTER_FIELD_REDUCE, 
+                     (void(*)())tfilter_FieldReduce, NULL,
+                     TFILTER_FIELD_REDUCE_FORMATSTR );
+
+    TFILTER_QUANTILE_SKETCH = tfilter_start++;
+    register_Filter(filterInfo, TFILTER_QUANTILE_SKETCH, 
+                     (void(*)())tfilter_QuantileSketch, NULL,
+                     TFILTER_QUANTILE_SKETCH_FORMATSTR,
+                     (void(*)())tfilter_QuantileSketch_accumulate,
+                     (void(*)())tfilter_QuantileSketch_finalize );
+
+    TFILTER_TOP_K = tfilter_start++;
+    register_Filter(filterInfo, TFILTER_TOP_K, 
+                     (void(*)())tfilter_TopK, NULL, TFILTER_TOP_K_FORMATSTR,
+                     (void(*)())tfilter_TopK_accumulate,
+                     (void(*)())tfilter_TopK_finalize );
+
+    TFILTER_HYPERLOGLOG = tfilter_start++;
+    register_Filter(filterInfo, TFILTER_HYPERLOGLOG, 
+                     (void(*)())tfilter_HyperLogLog, NULL,
+                     TFILTER_HYPERLOGLOG_FORMATSTR,
+                     (void(*)())tfilter_HyperLogLog_accumulate,
+                     (void(*)())tfilter_HyperLogLog_finalize );
+
+    TFILTER_RANGE_EQ_CLASS = tfilter_start++;
+    register_Filter(filterInfo, TFILTER_RANGE_EQ_CLASS, 
+                     (void(*)())tfilter_RangeEqClass, NULL,
+                     TFILTER_RANGE_EQ_CLASS_FORMATSTR,
+                     (void(*)())tfilter_RangeEqClass_accumulate,
+                     (void(*)())tfilter_RangeEqClass_finalize );
+
 #ifdef _NEED_PARADYN_FILTERS_
     TFILTER_SAVE_LOCAL_CLOCK_SKEW_UPSTREAM = tfilter_start++;
     register_Filter(filterInfo, TFILTER_SAVE_LOCAL_CLOCK_SKEW_UPSTREAM, 
@@ -177,6 +279,12 @@ inline void Filter::initialize_static_stuff( FilterInfoPtr filterInfo)
     SFILTER_TIMEOUT = sfilter_start++;
     register_Filter(filterInfo, SFILTER_TIMEOUT, 
                      (void(*)())sfilter_TimeOut, NULL, NULL_STRING );
+
+    // replaced by the stream's wave accumulator when its upstream filter
+    // is incremental
+    SFILTER_INCREMENTAL = sfilter_start++;
+    register_Filter(filterInfo, SFILTER_INCREMENTAL, 
+                     (void(*)())sfilter_WaitForAll, NULL, NULL_STRING );
 }
 
 inline void Filter::free_static_stuff( )
@@ -51,12 +51,137 @@ void tfilter_ArrayConcat( const std::vector < PacketPtr >&,
                           std::vector < PacketPtr >&, 
                           void**, PacketPtr&, const TopologyLocalInfo& );
 
+extern const char * TFILTER_ARRAY_SUM_FORMATSTR;
+void tfilter_ArraySum( const std::vector < PacketPtr >&, 
+                      std::vector < PacketPtr >&, 
+                      std::vector < PacketPtr >&, 
+                      void**, PacketPtr&, const TopologyLocalInfo& );
+
+extern const char * TFILTER_ARRAY_MIN_FORMATSTR;
+void tfilter_ArrayMin( const std::vector < PacketPtr >&, 
+                      std::vector < PacketPtr >&, 
+                      std::vector < PacketPtr >&, 
+                      void**, PacketPtr&, const TopologyLocalInfo& );
+
+extern const char * TFILTER_ARRAY_MAX_FORMATSTR;
+void tfilter_ArrayMax( const std::vector < PacketPtr >&, 
+                      std::vector < PacketPtr >&, 
+                      std::vector < PacketPtr >&, 
+                      void**, PacketPtr&, const TopologyLocalInfo& );
+
+extern const char * TFILTER_ARRAY_AVG_FORMATSTR;
+void tfilter_ArrayAvg( const std::vector < PacketPtr >&, 
+                      std::vector < PacketPtr >&, 
+                      std::vector < PacketPtr >&, 
+                      void**, PacketPtr&, const TopologyLocalInfo& );
+
+// incremental mode of the associative reductions (see SFILTER_INCREMENTAL)
+void tfilter_Sum_accumulate( const PacketPtr&, void**, void**, PacketPtr&,
+                             const TopologyLocalInfo& );
+void tfilter_Sum_finalize( void**, std::vector < PacketPtr >&,
+                           std::vector < PacketPtr >&,
+                           void**, PacketPtr&, const TopologyLocalInfo& );
+void tfilter_Min_accumulate( const PacketPtr&, void**, void**, PacketPtr&,
+                             const TopologyLocalInfo& );
+void tfilter_Min_finalize( void**, std::vector < PacketPtr >&,
+                           std::vector < PacketPtr >&,
+                           void**, PacketPtr&, const TopologyLocalInfo& );
+void tfilter_Max_accumulate( const PacketPtr&, void**, void**, PacketPtr&,
+                             const TopologyLocalInfo& );
+void tfilter_Max_finalize( void**, std::vector < PacketPtr >&,
+                           std::vector < PacketPtr >&,
+                           void**, PacketPtr&, const TopologyLocalInfo& );
+void tfilter_Avg_accumulate( const PacketPtr&, void**, void**, PacketPtr&,
+                             const TopologyLocalInfo& );
+void tfilter_Avg_finalize( void**, std::vector < PacketPtr >&,
+                           std::vector < PacketPtr >&,
+                           void**, PacketPtr&, const TopologyLocalInfo& );
+void tfilter_ArraySum_accumulate( const PacketPtr&, void**, void**, PacketPtr&,
+                                  const TopologyLocalInfo& );
+void tfilter_ArraySum_finalize( void**, std::vector < PacketPtr >&,
+                                std::vector < PacketPtr >&,
+                                void**, PacketPtr&, const TopologyLocalInfo& );
+void tfilter_ArrayMin_accumulate( const PacketPtr&, void**, void**, PacketPtr&,
+                                  const TopologyLocalInfo& );
+void tfilter_ArrayMin_finalize( void**, std::vector < PacketPtr >&,
+                                std::vector < PacketPtr >&,
+                                void**, PacketPtr&, const TopologyLocalInfo& );
+void tfilter_ArrayMax_accumulate( const PacketPtr&, void**, void**, PacketPtr&,
+                                  const TopologyLocalInfo& );
+void tfilter_ArrayMax_finalize( void**, std::vector < PacketPtr >&,
+                                std::vector < PacketPtr >&,
+                                void**, PacketPtr&, const TopologyLocalInfo& );
+void tfilter_ArrayAvg_accumulate( const PacketPtr&, void**, void**, PacketPtr&,
+                                  const TopologyLocalInfo& );
+void tfilter_ArrayAvg_finalize( void**, std::vector < PacketPtr >&,
+                                std::vector < PacketPtr >&,
+                                void**, PacketPtr&, const TopologyLocalInfo& );
+
+extern const char * TFILTER_FIELD_REDUCE_FORMATSTR;
+void tfilter_FieldReduce( const std::vector < PacketPtr >&, 
+                          std::vector < PacketPtr >&, 
+                          std::vector < PacketPtr >&, 
+                          void**, PacketPtr&, const TopologyLocalInfo& );
+
+/* relative accuracy, max buckets, first bucket, bucket counts, zero count,
+   min, max, sum. See QuantileSketch */
+extern const char * TFILTER_QUANTILE_SKETCH_FORMATSTR;
+void tfilter_QuantileSketch( const std::vector < PacketPtr >&, 
+                             std::vector < PacketPtr >&, 
+                             std::vector < PacketPtr >&, 
+                             void**, PacketPtr&, const TopologyLocalInfo& );
+void tfilter_QuantileSketch_accumulate( const PacketPtr&, void**, void**, PacketPtr&,
+                                        const TopologyLocalInfo& );
+void tfilter_QuantileSketch_finalize( void**, std::vector < PacketPtr >&,
+                                      std::vector < PacketPtr >&,
+                                      void**, PacketPtr&, const TopologyLocalInfo& );
+
+/* k, width, depth, count-min counters, candidate keys, total count.
+   See TopKSketch */
+extern const char * TFILTER_TOP_K_FORMATSTR;
+void tfilter_TopK( const std::vector < PacketPtr >&, 
+                   std::vector < PacketPtr >&, 
+                   std::vector < PacketPtr >&, 
+                   void**, PacketPtr&, const TopologyLocalInfo& );
+void tfilter_TopK_accumulate( const PacketPtr&, void**, void**, PacketPtr&,
+                              const TopologyLocalInfo& );
+void tfilter_TopK_finalize( void**, std::vector < PacketPtr >&,
+                            std::vector < PacketPtr >&,
+                            void**, PacketPtr&, const TopologyLocalInfo& );
+
+/* 2^precision registers, see HyperLogLog */
+extern const char * TFILTER_HYPERLOGLOG_FORMATSTR;
+enum { HLL_MIN_PRECISION = 4, HLL_MAX_PRECISION = 18 };
+/* the precision of a sketch of 'inum_registers', 0 if invalid */
+unsigned int get_HyperLogLogPrecision( uint64_t inum_registers );
+void tfilter_HyperLogLog( const std::vector < PacketPtr >&, 
+                          std::vector < PacketPtr >&, 
+                          std::vector < PacketPtr >&, 
+                          void**, PacketPtr&, const TopologyLocalInfo& );
+void tfilter_HyperLogLog_accumulate( const PacketPtr&, void**, void**, PacketPtr&,
+                                     const TopologyLocalInfo& );
+void tfilter_HyperLogLog_finalize( void**, std::vector < PacketPtr >&,
+                                   std::vector < PacketPtr >&,
+                                   void**, PacketPtr&, const TopologyLocalInfo& );
+
 extern const char * TFILTER_INT_EQ_CLASS_FORMATSTR;
 void tfilter_IntEqClass( const std::vector < PacketPtr >&, 
                          std::vector < PacketPtr >&, 
                          std::vector < PacketPtr >&, 
                          void**, PacketPtr&, const TopologyLocalInfo& );
 
+/* class values, number of ranges per class, [first, last] rank ranges */
+extern const char * TFILTER_RANGE_EQ_CLASS_FORMATSTR;
+void tfilter_RangeEqClass( const std::vector < PacketPtr >&, 
+                           std::vector < PacketPtr >&, 
+                           std::vector < PacketPtr >&, 
+                           void**, PacketPtr&, const TopologyLocalInfo& );
+void tfilter_RangeEqClass_accumulate( const PacketPtr&, void**, void**, PacketPtr&,
+                                      const TopologyLocalInfo& );
+void tfilter_RangeEqClass_finalize( void**, std::vector < PacketPtr >&,
+                                    std::vector < PacketPtr >&,
+                                    void**, PacketPtr&, const TopologyLocalInfo& );
+
 extern const char * TFILTER_PERFDATA_FORMATSTR;
 void tfilter_PerfData( const std::vector < PacketPtr >&, 
                        std::vector < PacketPtr >&, 
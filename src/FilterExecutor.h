@@ -0,0 +1,89 @@
+/****************************************************************************
+ *  Copyright 2003-2015 Dorian C. Arnold, Philip C. Roth, Barton P. Miller  *
+ *                  Detailed MRNet usage rights in "LICENSE" file.          *
+ ****************************************************************************/
+
+#if !defined(__filterexecutor_h)
+#define __filterexecutor_h 1
+
+#include <deque>
+#include <map>
+#include <vector>
+
+#include "mrnet/Network.h"
+#include "mrnet/Packet.h"
+#include "mrnet/Types.h"
+#include "xplat/Monitor.h"
+#include "xplat/Thread.h"
+
+namespace MRN
+{
+
+class Stream;
+
+/*
+ * Worker pool that runs the upstream filters of a parent node, used when
+ * MRNET_FILTER_THREADS enables it for the local node type.
+ *
+ * Receiving threads queue each stream's data packets here instead of
+ * filtering them inline. A stream is processed by at most one worker at a
+ * time, in arrival order, so filter state needs no more protection than
+ * before, while the filters of different streams run concurrently and an
+ * expensive stream no longer holds up the receiving threads.
+ */
+class FilterExecutor {
+
+ public:
+
+    FilterExecutor( Network * inetwork, unsigned int inum_workers );
+    ~FilterExecutor(void);
+
+    int start(void);
+
+    /* filters the packets still queued, then joins the workers. Packets
+       queued afterwards are dropped */
+    void stop(void);
+
+    /* queues the packets of one stream, in order, and clears 'ipackets'.
+       Workers look the stream up by id, so packets of a stream deleted in
+       the meantime are dropped */
+    int enqueue( unsigned int istrm_id, std::vector< PacketPtr > & ipackets );
+
+    /* forgets a stream that is being deleted. Packets still queued are
+       dropped, and the call waits for a worker filtering the stream */
+    void remove_Stream( unsigned int istrm_id );
+
+    /* returns -1 if no packets of the stream were queued yet */
+    int get_Stats( unsigned int istrm_id, filter_stats_t & ostats ) const;
+
+ private:
+
+    struct stream_queue_t {
+        std::deque< std::vector< PacketPtr > > batches;
+        bool scheduled;             /* in _ready, or being filtered */
+        bool running;
+        filter_stats_t stats;
+    };
+
+    static void * worker_main( void * iarg );
+    static void log_Stats( unsigned int istrm_id, const filter_stats_t & istats );
+
+    int proc_Stream( unsigned int istrm_id, std::vector< PacketPtr > & ipackets );
+
+    Network * _network;
+    unsigned int _num_workers;
+    bool _started, _stopping;
+
+    std::vector< XPlat::Thread::Id > _worker_ids;
+
+    std::map< unsigned int, stream_queue_t > _queues;
+    std::deque< unsigned int > _ready;  /* ids of streams with packets */
+
+    // protects _queues, _ready, and _stopping
+    mutable XPlat::Monitor _sync;
+    enum { MRN_STREAM_READY, MRN_STREAM_IDLE };
+};
+
+} // namespace MRN
+
+#endif /* __filterexecutor_h */
@@ -0,0 +1,92 @@
+/****************************************************************************
+ *  Copyright 2003-2015 Dorian C. Arnold, Philip C. Roth, Barton P. Miller  *
+ *                  Detailed MRNet usage rights in "LICENSE" file.          *
+ ****************************************************************************/
+
+#if !defined(__formatdescriptor_h)
+#define __formatdescriptor_h 1
+
+#include <string>
+#include <vector>
+
+#include "mrnet/DataElement.h"
+#include "mrnet/Types.h"
+#include "pdr.h"
+
+namespace MRN
+{
+
+/*
+ * Compiled form of a packet format string (e.g., "%d %s %alf").
+ *
+ * Each distinct format string is tokenized once and its descriptor is
+ * interned in a process-wide table, so packing, unpacking and sizing a
+ * packet walk a small array of fields instead of re-parsing the string.
+ * Descriptors are never destroyed; packets just keep a pointer to theirs.
+ *
+ * Encoded offsets are known for every field that is preceded only by
+ * scalars. For formats made up entirely of scalars, the encoded size of
+ * the payload is fixed and available without inspecting any data.
+ */
+class FormatDescriptor {
+
+ public:
+
+    typedef enum {
+        FIELD_UNKNOWN,
+        FIELD_SCALAR,       /* fixed-size value */
+        FIELD_BYTES,        /* counted char array, see pdr_bytes() */
+        FIELD_ARRAY,        /* counted array of scalars or strings */
+        FIELD_STRING        /* null-terminated string */
+    } FieldKind;
+
+    struct Field {
+        DataType type;
+        FieldKind kind;
+        pdrproc_t proc;         /* pdr routine for scalar or array element */
+        uint32_t elem_size;     /* in-memory size of an array element */
+        uint32_t encoded_size;  /* encoded size of scalar or array element,
+                                   0 if elements are variable-size */
+        uint64_t max_len;       /* maximum array length */
+        uint64_t offset;        /* encoded offset, or variable_offset */
+    };
+
+    static const uint64_t variable_offset = (uint64_t)-1;
+
+    /* returns the interned descriptor for 'fmt', never NULL */
+    static const FormatDescriptor * get( const char * fmt );
+
+    const char * get_FormatString(void) const { return _fmt.c_str(); }
+
+    size_t get_NumFields(void) const { return _fields.size(); }
+    const Field & get_Field( size_t i ) const { return _fields[i]; }
+
+    /* false if any token is not a known format specifier */
+    bool is_Valid(void) const { return _valid; }
+
+    /* true if the encoded payload size does not depend on the data */
+    bool is_FixedSize(void) const { return _fixed; }
+
+    /* encoded size of all scalars and length prefixes, which is the
+       exact payload size for fixed-size formats */
+    uint64_t get_FixedSize(void) const { return _fixed_size; }
+
+    /* computes the encoded payload size for 'elems', returns false if
+       the elements cannot be encoded (e.g., a NULL string) */
+    bool get_EncodedSize( const DataElement * elems, size_t num_elems,
+                          uint64_t & size ) const;
+
+ private:
+
+    FormatDescriptor( const char * fmt );
+
+    std::string _fmt;
+    std::vector< Field > _fields;
+    bool _valid;
+    bool _fixed;
+    uint64_t _fixed_size;
+};
+
+} // namespace MRN
+
+#endif /* __formatdescriptor_h */
@@ -0,0 +1,64 @@
+/****************************************************************************
+ *  Copyright 2003-2015 Dorian C. Arnold, Philip C. Roth, Barton P. Miller  *
+ *                  Detailed MRNet usage rights in "LICENSE" file.          *
+ ****************************************************************************/
+
+#if !defined(__fragmentassembler_h)
+#define __fragmentassembler_h 1
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "mrnet/Packet.h"
+#include "mrnet/Types.h"
+#include "xplat/Mutex.h"
+
+namespace MRN
+{
+
+/*
+ * Splitting of large packets into PROT_FRAGMENT packets (see Protocol.h),
+ * and reassembly of the fragments on the receiving side.
+ *
+ * Fragments reference the payload of the original packet rather than
+ * copying it, and hold a reference to that packet until they are sent.
+ * A receiver copies each fragment into the reassembled payload as it
+ * arrives, so only one copy of a large packet is buffered per node.
+ */
+class FragmentAssembler {
+
+ public:
+
+    FragmentAssembler(void);
+    ~FragmentAssembler(void);
+
+    /* splits 'ipacket' into fragments of at most 'ifrag_len' payload
+       bytes, originating from 'ilocal_rank'. Returns -1 on failure */
+    static int split_Packet( PacketPtr ipacket, uint64_t ifrag_len,
+                             Rank ilocal_rank,
+                             std::vector< PacketPtr > & ofrags );
+
+    /* adds a received fragment. Returns 1 and sets 'opacket' when the
+       fragment completes its packet, 0 if more fragments are needed, and
+       -1 if the fragment is malformed or out of order, in which case the
+       partial packet is discarded */
+    int add_Fragment( PacketPtr ifrag, PacketPtr & opacket );
+
+ private:
+
+    struct Partial {
+        char * buf;
+        uint64_t len;
+        uint64_t received;
+    };
+
+    typedef std::pair< Rank, uint64_t > FragmentKey; /* origin, sequence */
+
+    std::map< FragmentKey, Partial > _partials;
+    XPlat::Mutex _sync;
+};
+
+} // namespace MRN
+
+#endif /* __fragmentassembler_h */
@@ -18,6 +18,9 @@ class FrontEndNode: public virtual ParentNode {
     FrontEndNode(Network *, std::string const& ihostname, Rank irank);
     virtual ~FrontEndNode(void);
     virtual int proc_DataFromChildren(PacketPtr ipacket ) const;
+    virtual int proc_DataFromChildren( std::vector< PacketPtr > & ipackets ) const;
+    virtual int proc_StreamDataFromChildren( Stream * istrm,
+                                             std::vector< PacketPtr > & ipackets ) const;
     int proc_NewParentReportFromParent( PacketPtr ipacket ) const;
 };
 
@@ -0,0 +1,102 @@
+/****************************************************************************
+ *  Copyright 2003-2015 Dorian C. Arnold, Philip C. Roth, Barton P. Miller  *
+ *                  Detailed MRNet usage rights in "LICENSE" file.          *
+ ****************************************************************************/
+
+#if !defined(__ioengine_h)
+#define __ioengine_h 1
+
+#if defined(os_linux)
+
+#include <list>
+#include <map>
+#include <vector>
+
+#include "mrnet/Network.h"
+#include "mrnet/Types.h"
+#include "xplat/Monitor.h"
+#include "xplat/SocketUtils.h"
+#include "xplat/Thread.h"
+
+namespace MRN
+{
+
+/*
+ * Event-driven alternative to the per-peer send/recv threads, used for the
+ * child links of a parent node when MRNET_IO_ENGINE selects its node type.
+ *
+ * A single reactor thread waits in epoll for readable child data sockets
+ * and queues them for a small pool of worker threads. A worker reads all
+ * available bytes without blocking, processes the completely received
+ * packets, and re-arms the socket (one-shot registration ensures only one
+ * worker reads a peer at a time). PeerNode::send() queues a send task for
+ * the peer, which a worker completes with Message::send_Available(). When
+ * the socket is full, the rest of the frame waits for EPOLLOUT on the same
+ * registration, so a slow child never holds a worker. Once a shutdown
+ * packet has been sent to a peer, the engine sends nothing more to it.
+ */
+class IOEngine {
+
+ public:
+
+    IOEngine( Network * inetwork, unsigned int inum_workers );
+    ~IOEngine(void);
+
+    int start(void);
+    void stop(void);
+
+    int add_Peer( PeerNodePtr ipeer );
+    void post_Send( Rank irank );
+
+ private:
+
+    /* the engine keeps its own references to its peers, so workers never
+       need the network's children lock */
+    struct peer_state_t {
+        PeerNodePtr peer;
+        XPlat_Socket sock;
+        uint32_t gen;
+        bool send_posted;
+        bool read_busy;     // read task pending, EPOLLIN is not armed
+        bool want_write;    // partial frame waits for EPOLLOUT
+        bool send_done;     // shutdown sent, peer removed from sending
+    };
+
+    typedef struct {
+        Rank rank;
+        uint32_t gen;
+        bool is_send;
+    } io_task_t;
+
+    static void * reactor_main( void * iarg );
+    static void * worker_main( void * iarg );
+
+    void proc_Readable( PeerNodePtr ipeer, uint32_t igen );
+    void proc_Sendable( PeerNodePtr ipeer, uint32_t igen );
+
+    // caller must hold _sync
+    void queue_Send( Rank irank, peer_state_t & istate );
+    void rearm_Peer( Rank irank, peer_state_t & istate );
+
+    Network * _network;
+    int _epoll_fd, _wakeup_fd;
+    unsigned int _num_workers;
+    uint32_t _next_gen;
+    bool _started, _stopping;
+
+    XPlat::Thread::Id _reactor_id;
+    std::vector< XPlat::Thread::Id > _worker_ids;
+
+    std::map< Rank, peer_state_t > _peers;
+    std::list< io_task_t > _tasks;
+
+    // protects _peers, _tasks, and _stopping
+    XPlat::Monitor _sync;
+    enum { MRN_TASK_AVAILABLE };
+};
+
+} // namespace MRN
+
+#endif /* os_linux */
+
+#endif /* __ioengine_h */
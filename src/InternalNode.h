@@ -33,6 +33,9 @@ class InternalNode: public virtual ParentNode,
     void waitLoop() const;
     virtual int proc_DataFromParent( PacketPtr ipacket ) const;
     virtual int proc_DataFromChildren( PacketPtr ipacket ) const;
+    virtual int proc_DataFromChildren( std::vector< PacketPtr > & ipackets ) const;
+    virtual int proc_StreamDataFromChildren( Stream * istrm,
+                                             std::vector< PacketPtr > & ipackets ) const;
 };
 
 } // namespace MRN
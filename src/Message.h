@@ -7,6 +7,8 @@
 #define Message_h
 
 #include <list>
+#include <map>
+#include <string>
 #include <vector>
 
 #include "utils.h"
@@ -21,32 +23,139 @@
 
 #define MESSAGE_PREALLOC_LEN 10
 
+/* read-ahead buffer size, and minimum payload size received directly
+   into its packet buffer rather than staged through read-ahead */
+#define MESSAGE_READAHEAD_LEN (256 * 1024)
+#define MESSAGE_READAHEAD_DIRECT_LEN (64 * 1024)
+
+/* maximum normal priority payload sent per frame, so that priority
+   packets queued during a long send wait for at most one batch */
+#define MESSAGE_SEND_BATCH_LEN (1024 * 1024)
+
 namespace MRN
 {
 
+/* bytes sent and received on all links, including framing and headers */
 uint64_t get_TotalBytesSend(void);
 uint64_t get_TotalBytesRecv(void);
 
 class Message: public Error{
  public:
-    Message( Network * net );
+    /* ifmt_dict enables the link format dictionary (see FormatCodes in
+       Protocol.h), for Messages that stay with one end of a data link */
+    Message( Network * net, bool iread_ahead=false, bool ifmt_dict=false );
     ~Message();
 
+    /* sends the queued packets. ogo_away is set if a shutdown packet
+       (PROT_SHUTDOWN or PROT_SHUTDOWN_ACK) was sent, after which nothing
+       more should be sent on the link; the caller decides whether that
+       ends its thread */
     int send( XPlat_Socket isock_fd );
+    int send( XPlat_Socket isock_fd, bool &ogo_away );
     int recv( XPlat_Socket isock_fd, 
               std::list < PacketPtr >&opackets, Rank iinlet_rank );
 
-    void add_Packet( PacketPtr );
+    /* Queues a packet to send. While the queue is at its limits, user
+       data packets block the caller until the sender drains the queue,
+       unless iblock is false. Once the queue is closed, such packets are
+       dropped and -1 is returned.
+
+       Out-of-band control reports (events, failure and recovery reports,
+       topology and port updates) and packets of high priority streams are
+       queued in a priority lane that send() drains ahead of the normal
+       lane. Other control packets stay ordered with earlier data. */
+    int add_Packet( PacketPtr, bool iblock=false );
     size_t size_Packets( void );
+
+    /* bounded send queue: limits of 0 mean unbounded */
+    void set_QueueLimits( size_t imax_packets, size_t imax_bytes );
+    bool is_QueueFull( void );
+    void close_Queue( void );
+    void get_QueueStats( queue_stats_t & ostats );
    
     void waitfor_MessagesToSend( void );
 
+    /* send coalescing: waitfor_MessagesToSend() holds queued packets for
+       up to imax_usec (adapted to traffic) unless ipkts packets or ibytes
+       bytes are queued, a flush is requested, or an urgent packet is
+       queued. A zero delay disables coalescing. */
+    void set_CoalescePolicy( unsigned int imax_usec, size_t imax_bytes,
+                             unsigned int imax_packets );
+    void request_Flush( void );
+
+    /* true if read-ahead holds bytes not yet returned by recv() */
+    bool has_BufferedData( void ) const;
+
+    /* non-blocking recv for read-ahead messages: reads whatever the socket
+       has available and returns the completely received packets. Returns
+       -1 if the connection failed or was closed, after returning any
+       packets that were fully received before that. A Message is received
+       either by recv() or by recv_Available(), not both */
+    int recv_Available( XPlat_Socket isock_fd, 
+                        std::list < PacketPtr >&opackets, Rank iinlet_rank );
+
+    /* non-blocking send: writes queued frames until the socket is full.
+       A frame left partially written is finished by the next call to
+       send_Available() or send(). Returns 1 if the socket would block with
+       data still to send, 0 otherwise (more packets may be queued if the
+       call stopped early to let other connections run), or -1 on failure.
+       ogo_away is set as for send() */
+    int send_Available( XPlat_Socket isock_fd, bool &ogo_away );
+
  private:
 
+    /* packet header as sent on a link: varint encoded packet header
+       fields, with the format string replaced by a format code */
+    struct LinkHeader {
+        uint32_t stream_id;
+        int32_t tag;
+        Rank src_rank;
+        uint32_t fmt_code;
+        char *fmt_str;          /* NULL for dictionary references */
+        uint64_t dest_arr_len;
+        Rank *dest_arr;
+        char byteorder;         /* of the packet data buffer */
+    };
+    static int pdr_link_header( struct PDR *, LinkHeader * );
+    void encode_LinkHeader( PacketPtr &ipacket, LinkHeader &ohdr );
+    int new_RecvPacket( XPlat::SocketUtils::NCBuf &ihdr,
+                        XPlat::SocketUtils::NCBuf &ibuf,
+                        Rank iinlet_rank, PacketPtr &opacket );
+
+    int recv_ReadAhead( XPlat_Socket isock_fd, 
+                        std::list < PacketPtr >&opackets, Rank iinlet_rank );
+    int recv_Frame( XPlat_Socket isock_fd, 
+                    std::list < PacketPtr >&opackets, Rank iinlet_rank,
+                    bool iblock );
+    int send_Frame( XPlat_Socket isock_fd, std::list< PacketPtr > &ipackets,
+                    bool &ogo_away );
+    int begin_Frame( std::list< PacketPtr > &ipackets );
+    int write_Frame( XPlat_Socket isock_fd, bool iblock );
+    void end_Frame( bool isent );
+    void take_SendBatch( std::list< PacketPtr > &opackets, size_t &ionormal_left );
+    bool is_PriorityPacket( PacketPtr &ipacket ) const;
+    size_t num_Queued( void ) const
+    { return _packets.size() + _priority_packets.size(); }
+    int recv_FrameAvailable( std::list < PacketPtr >&opackets, Rank iinlet_rank );
+    bool is_RecvDirect( void ) const;
+    void release_RecvFrame( void );
+    int fill_ReadAhead( XPlat_Socket isock_fd, size_t ilen );
+    int reserve_ReadAhead( size_t ilen );
+    void set_RecvPerfData( std::list < PacketPtr >&ipackets, Timer it );
+
     Network * _net;
-    enum {MRN_QUEUE_NONEMPTY};
+    enum {MRN_QUEUE_NONEMPTY, MRN_QUEUE_SPACE};
 
+    /* outbound lanes, _packets_bytes counts payload bytes in both */
     std::list< PacketPtr > _packets;
+    std::list< PacketPtr > _priority_packets;
+    size_t _packets_bytes;
+    bool _send_now;
+
+    /* send queue limits and high-water marks, see set_QueueLimits() */
+    size_t _max_packets, _max_bytes;
+    size_t _peak_packets, _peak_bytes;
+    bool _queue_closed;
     XPlat::Monitor _packet_sync;
     XPlat::Monitor _send_sync;
 
@@ -56,6 +165,50 @@ class Message: public Error{
 
     uint64_t _packet_sizes[MESSAGE_PREALLOC_LEN];
     XPlat::SocketUtils::NCBuf _ncbuf[MESSAGE_PREALLOC_LEN];
+
+    /* send coalescing policy, _coalesce_usec is the current window */
+    unsigned int _coalesce_max_usec, _coalesce_usec, _coalesce_max_packets;
+    size_t _coalesce_max_bytes;
+
+    /* read-ahead buffer, bytes [_ra_begin, _ra_end) are unconsumed.
+       _ra_need is the length of the partially buffered next frame, as far
+       as it is known, after a non-blocking recv_Frame(), or of the next
+       frame header for recv_FrameAvailable() */
+    bool _read_ahead;
+    char *_ra_buf;
+    size_t _ra_size, _ra_begin, _ra_end, _ra_need;
+
+    /* frame being received by recv_Available(). Its packet buffers are
+       allocated once the size vector is parsed, and buffer _rf_cur holds
+       _rf_filled bytes so far. _rf_bytes counts the frame bytes received */
+    bool _rf_active;
+    uint32_t _rf_num_packets, _rf_cur;
+    size_t _rf_filled, _rf_bytes;
+    std::vector< XPlat::SocketUtils::NCBuf > _rf_bufs;
+
+    /* frame being sent. It holds references to its packets until it is
+       completely written. Buffers before _sf_cur are written, and the
+       written part of buffer _sf_cur has been cut off its front, so a
+       frame that send_Available() could not finish resumes where it
+       stopped. _sf_go_away is set if the frame holds a shutdown packet.
+       _sf_sizes_buf is the size vector if it was allocated */
+    bool _sf_active, _sf_go_away;
+    std::list< PacketPtr > _sf_packets;
+    std::vector< XPlat::SocketUtils::NCBuf > _sf_bufs;
+    size_t _sf_cur, _sf_bytes;
+    char *_sf_sizes_buf;
+
+    /* link format dictionaries. The first frame sent never defines
+       entries, as the accepting end of a new data link reads it before
+       the link's Message exists */
+    bool _fmt_dict, _sent_frame;
+    std::map< const char *, uint32_t > _send_fmt_dict; /* interned strings */
+    std::vector< const FormatDescriptor * > _recv_fmt_dict;
+
+    /* encoded link headers of the frame being sent */
+    std::vector< LinkHeader > _link_hdrs;
+    char *_link_hdr_buf;
+    size_t _link_hdr_buf_len;
 };
 
 ssize_t MRN_send( XPlat_Socket fd, const char *buf, size_t count );
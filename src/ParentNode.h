@@ -9,6 +9,7 @@
 #include <map>
 #include <list>
 #include <string>
+#include <vector>
 
 #include "mrnet/CommunicationNode.h"
 #include "mrnet/Error.h"
@@ -45,6 +46,15 @@ class ParentNode: public virtual Error,
 
     virtual int proc_DataFromChildren( PacketPtr ipacket ) const = 0;
 
+    /* processes data packets from one received message as a batch,
+       filtering the packets of each stream together */
+    virtual int proc_DataFromChildren( std::vector< PacketPtr > & ipackets ) const = 0;
+
+    /* filters packets of one stream and forwards the results, used by
+       the filter executor's workers */
+    virtual int proc_StreamDataFromChildren( Stream * istrm,
+                                             std::vector< PacketPtr > & ipackets ) const = 0;
+
     int proc_ControlProtocolAck( PacketPtr ipacket ); 
     bool waitfor_ControlProtocolAcks( int ack_tag, 
                                       unsigned num_acks_expected ) const;
@@ -109,10 +119,14 @@ class ParentNode: public virtual Error,
     mutable unsigned _filter_children_waiting;
     virtual int proc_PacketFromChildren( PacketPtr ipacket );
 
+    static bool is_DataFromChildren( const PacketPtr & ipacket );
+    static void sort_PacketsByStream( std::vector< PacketPtr > & ipackets );
+
     ParentNode() {}
 
  private:
     int abort_ControlProtocol( struct ControlProtocol &cp );
+    int dispatch_DataFromChildren( std::vector< PacketPtr > & ipackets );
     XPlat_Socket listening_sock_fd;
 
 };
@@ -27,12 +27,14 @@ namespace MRN
 {
 
 class ChildNode;
+class IOEngine;
 class ParentNode;
 class Network;
 class Packet;
 
 class PeerNode: public CommunicationNode, public Error {
     friend class ChildNode;
+    friend class IOEngine;
     friend class Network;
     friend class ParentNode;
  public:
@@ -55,9 +57,12 @@ class PeerNode: public CommunicationNode, public Error {
     void close_EventSocket(void);
 
     void send( PacketPtr ) const;
+    bool is_SendQueueFull(void) const;
+    void get_SendQueueStats( queue_stats_t & ostats ) const;
     int sendDirectly( PacketPtr ipacket ) const;
     int flush( bool ignore_threads=false ) const;
     int recv( std::list <PacketPtr> & ) const; //blocking recv
+    int recv_Available( std::list <PacketPtr> & ) const; //non-blocking recv
 
     bool has_data(void) const;
     bool is_backend(void) const;
@@ -68,6 +73,7 @@ class PeerNode: public CommunicationNode, public Error {
     int start_CommunicationThreads(void);    
     void waitfor_CommunicationThreads(void) const;
     bool stop_CommunicationThreads(void);
+    bool uses_IOEngine(void) const { return _io_engine != NULL; }
     
     int waitfor_FlushCompletion(void) const;
     void signal_FlushComplete(void) const;
@@ -82,6 +88,8 @@ class PeerNode: public CommunicationNode, public Error {
     PeerNode( Network *, std::string const& ihostname, Port iport, Rank irank,
               bool iis_parent, bool iis_internal );
 
+    void proc_RecvEnd(void);
+
 
     //Static data members
     Network * _network;
@@ -91,6 +99,7 @@ class PeerNode: public CommunicationNode, public Error {
     bool _is_parent;
     bool _recv_thread_started, _send_thread_started;
     XPlat::Thread::Id recv_thread_id, send_thread_id;
+    IOEngine * _io_engine;  // when set, replaces the send/recv threads
 
     //Dynamic data members
 
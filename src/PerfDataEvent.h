@@ -29,6 +29,9 @@ class PerfDataMgr {
     void disable( perfdata_metric_t, perfdata_context_t );
     bool is_Enabled( perfdata_metric_t, perfdata_context_t );
 
+    // true if elapsed time is collected for any packet context
+    bool is_PacketTimingEnabled(void);
+
     static std::string get_MetricName( perfdata_metric_t );
     static std::string get_MetricUnits( perfdata_metric_t );
     static std::string get_MetricDescription( perfdata_metric_t );
@@ -43,9 +43,32 @@ enum ProtocolTags {
 /* 29 */     PROT_NET_SETTINGS,
 /* 30 */     PROT_EDT_SHUTDOWN,
 /* 31 */     PROT_EDT_REMOTE_SHUTDOWN,
-/* 32 */     PROT_LAST
+/* 32 */     PROT_FRAGMENT,
+/* 33 */     PROT_LAST
 };
 
+/* User data packets with payloads larger than MRNET_SEND_FRAGMENT_BYTES
+   are sent to children as a series of PROT_FRAGMENT packets on the same
+   stream, in payload order. Internal nodes forward the fragments of
+   streams without a downstream filter as they arrive; back-ends and
+   filtering internal nodes reassemble the packet. Fields are: origin
+   rank and sequence number (which identify the packet), the packet's
+   tag, source rank, format string and payload byte order, the payload
+   length, and the offset and bytes of this fragment. */
+#define FRAGMENT_FMT "%ud %uld %d %ud %s %c %uld %uld %Ac"
+
+/* Format string field of the packet headers sent on data links. Each end
+   of a link keeps a format dictionary: a format string sent with
+   FMT_CODE_DEFINE gets the next dictionary index, and later packets
+   with that format send code FMT_CODE_FIRST_REF + index instead. */
+enum FormatCodes {
+    FMT_CODE_LITERAL = 0,       /* string follows, not remembered */
+    FMT_CODE_DEFINE,            /* string follows, added to dictionary */
+    FMT_CODE_FIRST_REF          /* dictionary references start here */
+};
+#define FMT_DICT_MAX_ENTRIES 1024
+
+
 #ifdef __cplusplus
 } // namespace MRN
 #endif 
@@ -8,42 +8,90 @@
 
 #include <map>
 #include <set>
+#include <vector>
 
+#include "mrnet/Event.h"
+#include "mrnet/Types.h"
 #include "xplat/Mutex.h"
 
 namespace MRN
 {
 
+/*
+ * Per-stream timeouts of the event detection thread (EDT), e.g., for
+ * sfilter_TimeOut.
+ *
+ * Timeouts are kept as absolute deadlines on a monotonic clock in a
+ * min-heap, so registering and expiring a timeout is O(log n) and the
+ * EDT only looks at the earliest deadline. A cleared timeout is left in
+ * the heap and skipped once it reaches the top.
+ *
+ * With no timeout pending, the EDT blocks until a socket event (or the
+ * MRNET_EVENT_WAIT_TIMEOUT_MSEC wait, if set). When a thread registers a
+ * timeout earlier than the EDT's current wait, or disables the EDT, the
+ * EDT is woken through the wakeup pipe. Timeouts are registered in msecs,
+ * but the EDT waits for the earliest deadline in usecs.
+ */
 class TimeKeeper {
 
  public:
 
-    TimeKeeper(void) : 
-        _min_timeout(default_timeout)
-    {}
+    TimeKeeper(void);
+    ~TimeKeeper(void);
 
-    /* get minimum timeout in milliseconds */
-    int get_Timeout() const;
+    /* usecs until the earliest timeout, capped by the default event wait.
+       -1 means wait for the next event */
+    int64_t get_TimeoutUsec(void);
 
+    /* the longest event wait, -1 for none */
     void set_DefaultTimeout(int default_ms);
 
-    /* update registered timeouts based on elapsed time,
-       fills set of stream ids whose timers have expired */
-    void notify_Elapsed( unsigned int elapsed_ms, std::set< unsigned int >& expired_streams );
+    /* fills set of stream ids whose timers have expired */
+    void get_Expired( std::set< unsigned int >& expired_streams );
 
     /* register/clear timeout for specified stream */
     bool register_Timeout( unsigned int strm_id, unsigned int timeout_ms );
     bool clear_Timeout( unsigned int strm_id );
 
+    /* readable after an earlier timeout was registered, -1 if the platform
+       has no wakeup pipe. The EDT calls clear_Wakeup() when it is */
+    int get_WakeupFd(void);
+    void clear_Wakeup(void);
+
+    /* wakes the EDT, e.g., so it notices that it has been disabled */
+    void signal_Wakeup(void);
+
+    /* usecs on the monotonic clock (wall clock where there is none) */
+    static uint64_t get_Now(void);
+
  private:
 
+    struct deadline_t {
+        uint64_t usec;              /* monotonic clock */
+        unsigned int strm_id;
+        uint64_t seq;               /* registration, to skip cleared ones */
+    };
+
+    struct later_deadline {
+        bool operator()( const deadline_t & a, const deadline_t & b ) const
+        {
+            return a.usec > b.usec;
+        }
+    };
+
+    bool is_Live( const deadline_t & d ) const;
+    void pop_Stale(void);
+
     static int default_timeout;
 
-    /* minimum timeout in ms */
-    int _min_timeout;
+    std::vector< deadline_t > _heap;
+    std::map< unsigned int, uint64_t > _strm_seqs; /* seq of live timeouts */
+    uint64_t _next_seq;
+
+    /* when the EDT will check the timeouts next, ~0 if it is blocked */
+    uint64_t _wait_deadline;
+    EventPipe _wakeup;
 
-    /* map< stream id, timeout in ms > */
-    std::map< unsigned int, unsigned int > _strm_timeouts;
     mutable XPlat::Mutex _tk_mutex;
 };
 
@@ -0,0 +1,93 @@
+/****************************************************************************
+ *  Copyright 2003-2015 Dorian C. Arnold, Philip C. Roth, Barton P. Miller  *
+ *                  Detailed MRNet usage rights in "LICENSE" file.          *
+ ****************************************************************************/
+
+#if !defined(__waveaccumulator_h)
+#define __waveaccumulator_h 1
+
+#include <deque>
+#include <map>
+#include <vector>
+
+#include "mrnet/NetworkTopology.h"
+#include "mrnet/Packet.h"
+#include "mrnet/Types.h"
+#include "xplat/Mutex.h"
+
+namespace MRN
+{
+
+class Filter;
+class Network;
+class Stream;
+
+/*
+ * Upstream synchronization of a stream using SFILTER_INCREMENTAL with an
+ * incremental upstream filter.
+ *
+ * Like sfilter_WaitForAll, wave i holds the i-th packet from each child,
+ * but each packet is folded into its wave by the filter's accumulate
+ * function as soon as it arrives, rather than queued until the wave is
+ * complete. Only one partial result per open wave is kept, and the filter
+ * work is spread over the arrivals instead of done at the last one.
+ *
+ * A wave is finalized once every child contributed, in wave order. With a
+ * timeout (the "%ud" sync filter parameter), the oldest wave is finalized
+ * after that many msecs without completing, and children that had not
+ * contributed to it yet add their next packet to the following wave.
+ */
+class WaveAccumulator {
+
+ public:
+
+    WaveAccumulator( Network * inetwork, Stream * istrm, Filter * ifilter,
+                     Filter * isync_filter );
+    ~WaveAccumulator(void);
+
+    /* folds 'ipackets' into their waves, appending the result of each
+       wave that completed to 'opackets'. An empty 'ipackets' means the
+       wave timeout expired */
+    int push_Packets( std::vector< PacketPtr > & ipackets,
+                      std::vector< PacketPtr > & opackets,
+                      std::vector< PacketPtr > & opackets_reverse,
+                      const TopologyLocalInfo & info );
+
+ private:
+
+    struct wave_t {
+        void * data;            /* the filter's partial result */
+        size_t num_arrived;     /* children that contributed */
+    };
+
+    struct inlet_t {
+        uint64_t next_wave;     /* wave of the next packet from the inlet */
+        bool is_child;
+    };
+
+    void update_Inlets(void);
+    void finalize_Front( std::vector< PacketPtr > & opackets,
+                         std::vector< PacketPtr > & opackets_reverse,
+                         const TopologyLocalInfo & info );
+    void update_Timeout(void);
+
+    Network * _network;
+    Stream * _strm;
+    Filter * _filter;
+    Filter * _sync_filter;      /* holds the timeout parameter */
+
+    unsigned int _peers_epoch, _removal_epoch;
+    std::map< Rank, inlet_t > _inlets;
+    size_t _num_children;
+
+    std::deque< wave_t > _waves;    /* open waves, oldest first */
+    uint64_t _base_wave;            /* number of _waves.front() */
+    bool _timer_active;
+    uint64_t _timer_wave;           /* wave the timeout was set for */
+
+    XPlat::Mutex _sync;
+};
+
+} // namespace MRN
+
+#endif /* __waveaccumulator_h */
@@ -16,6 +16,68 @@ void byte_swap(char * out, char * in, uint32_t nelems, uint32_t elemsize)
     }
 }
 
+/*
+ * Each 64-bit word holds several whole elements, so swapping bytes within
+ * 16-bit lanes, then 16-bit halves within 32-bit lanes, then the 32-bit
+ * halves, byte swaps 2, 4 and 8 byte elements respectively. Words are
+ * loaded and stored with memcpy, so neither buffer needs to be aligned.
+ */
+#define SWAP_LANES16(w) \
+    ( (((w) & (uint64_t)0x00ff00ff00ff00ffULL) << 8) | \
+      (((w) >> 8) & (uint64_t)0x00ff00ff00ff00ffULL) )
+#define SWAP_LANES32(w) \
+    ( (((w) & (uint64_t)0x0000ffff0000ffffULL) << 16) | \
+      (((w) >> 16) & (uint64_t)0x0000ffff0000ffffULL) )
+#define SWAP_LANES64(w) \
+    ( ((w) << 32) | ((w) >> 32) )
+
+void byte_swap_array(char * out, char * in, uint64_t nelems, uint32_t elemsize)
+{
+    uint64_t nbytes = nelems * elemsize;
+    uint64_t nwords = nbytes / sizeof(uint64_t);
+    uint64_t i, w, done;
+
+    switch( elemsize ) {
+    case 1:
+        if( out != in )
+            memcpy(out, in, (size_t)nbytes);
+        return;
+    case 2:
+        for( i = 0; i < nwords; i++ ) {
+            memcpy(&w, in + i*sizeof(w), sizeof(w));
+            w = SWAP_LANES16(w);
+            memcpy(out + i*sizeof(w), &w, sizeof(w));
+        }
+        break;
+    case 4:
+        for( i = 0; i < nwords; i++ ) {
+            memcpy(&w, in + i*sizeof(w), sizeof(w));
+            w = SWAP_LANES16(w);
+            w = SWAP_LANES32(w);
+            memcpy(out + i*sizeof(w), &w, sizeof(w));
+        }
+        break;
+    case 8:
+        for( i = 0; i < nwords; i++ ) {
+            memcpy(&w, in + i*sizeof(w), sizeof(w));
+            w = SWAP_LANES16(w);
+            w = SWAP_LANES32(w);
+            w = SWAP_LANES64(w);
+            memcpy(out + i*sizeof(w), &w, sizeof(w));
+        }
+        break;
+    default:
+        nwords = 0;
+        break;
+    }
+
+    /* trailing elements that do not fill a word */
+    done = nwords * sizeof(uint64_t);
+    if( done < nbytes )
+        byte_swap(out + done, in + done,
+                  (uint32_t)((nbytes - done) / elemsize), elemsize);
+}
+
 #define SWAP2(a, b) {char t; t = *(a); *(a)=*(b); *(b)=t;}
 void byte_swap_inplace(char * inout, uint32_t nelems, uint32_t elemsize)
 {
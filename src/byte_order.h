@@ -45,6 +45,9 @@ void byte_swap(char * out, char * in, uint32_t nelems, uint32_t elemsize);
 #define swap_double(out, in) \
     byte_swap((char *) out, (char *)in, 1, (uint32_t) sizeof(double) );
 
+/* Swaps a whole array of 2, 4 or 8 byte elements, a 64-bit word at a time */
+void byte_swap_array(char * out, char * in, uint64_t nelems, uint32_t elemsize);
+
 void byte_swap_inplace(char * inout, uint32_t nelems, uint32_t elemsize);
 #define swap_inplace_int16(in) \
         byte_swap_inplace((char *)in, 1, (uint32_t) sizeof(uint16_t) );
@@ -86,7 +86,17 @@ BackEndNode_t* new_BackEndNode_t(Network_t* inetwork,
 
 void delete_BackEndNode_t( BackEndNode_t* be )
 {
+    size_t i;
+
     if( be != NULL ) {
+        if( be->fragments != NULL ) {
+            for( i = 0; i < be->fragments->size; i++ ) {
+                FragmentPartial_t* partial = (FragmentPartial_t*) be->fragments->vec[i];
+                free( partial->buf );
+                free( partial );
+            }
+            delete_vector_t( be->fragments );
+        }
         if( be->myhostname != NULL )
 	    free( be->myhostname );
         if( be->phostname != NULL )
@@ -143,6 +153,8 @@ int BackEndNode_proc_newStream( BackEndNode_t* be, Packet_t* packet )
     int tag;
     /* Safe since filters are not used in lightweight */
     int ds_filter_id = 0, us_filter_id = 0, sync_id = 0;
+    /* stream priority only orders queued sends, which are not used here */
+    int priority = 0;
     char* us_filters;
     char* sync_filters;
     char* ds_filters;
@@ -155,9 +167,9 @@ int BackEndNode_proc_newStream( BackEndNode_t* be, Packet_t* packet )
     if (tag == PROT_NEW_HETERO_STREAM) {
         me = be->network->local_rank;
 
-        if (Packet_unpack(packet, "%d %ad %s %s %s",
+        if (Packet_unpack(packet, "%ud %ad %s %s %s %d",
             &stream_id, &backends, &num_backends, 
-            &us_filters, &sync_filters, &ds_filters) == -1) {
+            &us_filters, &sync_filters, &ds_filters, &priority) == -1) {
             mrn_dbg(1, mrn_printf(FLF, stderr, "Packet_unpack() failed\n"));
             return -1;
         }
@@ -181,9 +193,10 @@ int BackEndNode_proc_newStream( BackEndNode_t* be, Packet_t* packet )
     }
 
     else { // PROT_NEW_STREAM or PROT_NEW_INTERNAL_STREAM
-        if (Packet_unpack(packet, "%ud %ad %d %d %d", 
+        if (Packet_unpack(packet, "%ud %ad %d %d %d %d", 
                           &stream_id, &backends,&num_backends,
-                          &us_filter_id, &sync_id, &ds_filter_id) == -1) 
+                          &us_filter_id, &sync_id, &ds_filter_id,
+                          &priority) == -1) 
         {
             mrn_dbg(1, mrn_printf(FLF, stderr, "Packet_unpack() failed\n"));
             return -1;
@@ -20,10 +20,21 @@ struct BackEndNode_t {
     Port pport;
     Rank prank;
     uint16_t incarnation;
+    struct vector_t* fragments; /* FragmentPartial_t* of packets being
+                                   reassembled, see Protocol.h */
 };
 
 typedef struct BackEndNode_t BackEndNode_t;
 
+/* a fragmented packet, identified by its origin rank and sequence number */
+typedef struct {
+    Rank origin;
+    uint64_t seq;
+    char* buf;
+    uint64_t len;
+    uint64_t received;
+} FragmentPartial_t;
+
 /* functions */
 
 BackEndNode_t* new_BackEndNode_t( Network_t* inetwork,
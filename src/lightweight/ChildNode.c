@@ -99,6 +99,7 @@ int ChildNode_init_newChildEventConnection(BackEndNode_t* be,
 {
     int retval = 0;
     Packet_t* packet;
+    Message_t msg;
     const char* fmt_str = "%s %uhd %ud";
     int num_retry = 5;
 
@@ -120,8 +121,10 @@ int ChildNode_init_newChildEventConnection(BackEndNode_t* be,
   
     mrn_dbg(5, mrn_printf(FLF, stderr, "Initializing new Child FD Connection\n\n" ));
   
-    iparent->msg_out.packet = packet;  
-    if( Message_send(&(iparent->msg_out), iparent->event_sock_fd) == -1 ) { 
+    // the event link has no format dictionary
+    Message_init(&msg, false);
+    msg.packet = packet;  
+    if( Message_send(&msg, iparent->event_sock_fd) == -1 ) { 
         mrn_dbg(1, mrn_printf(FLF, stderr, "Message_send() failed\n"));
         retval = -1;
     }
@@ -320,6 +323,13 @@ int ChildNode_proc_PacketFromParent(BackEndNode_t* be, Packet_t* packet)
                 retval = -1;
             }
             break;
+        case PROT_FRAGMENT:
+            if( ChildNode_proc_Fragment(be, packet) == -1 ) {
+                mrn_dbg( 1, mrn_printf(FLF, stderr,
+                                       "proc_Fragment() failed\n" ));
+                retval = -1;
+            }
+            break;
         default:
             mrn_dbg( 3, mrn_printf(FLF, stderr,
                                    "internal protocol tag %d is unhandled\n", tag) );
@@ -346,6 +356,106 @@ int ChildNode_proc_PacketFromParent(BackEndNode_t* be, Packet_t* packet)
     return retval;
 }
 
+/* adds a fragment of a large data packet (see FRAGMENT_FMT), and delivers
+   the packet once all of its fragments have arrived in order */
+int ChildNode_proc_Fragment( BackEndNode_t* be, Packet_t* ipacket )
+{
+    DataElement_t** elems;
+    FragmentPartial_t* partial = NULL;
+    Packet_t* packet;
+    Rank origin, src;
+    uint64_t seq, total, offset, len;
+    int32_t tag;
+    char byteorder;
+    char* fmt;
+    char* buf;
+    size_t i;
+
+    mrn_dbg_func_begin();
+
+    if( (ipacket->data_elements == NULL) ||
+        (ipacket->data_elements->size != 9) ) {
+        mrn_dbg( 1, mrn_printf(FLF, stderr, "malformed fragment\n" ));
+        return -1;
+    }
+    elems = (DataElement_t**) ipacket->data_elements->vec;
+    origin = elems[0]->val.ud;
+    seq = elems[1]->val.uld;
+    tag = elems[2]->val.d;
+    src = elems[3]->val.ud;
+    fmt = (char*) elems[4]->val.p;
+    byteorder = elems[5]->val.c;
+    total = elems[6]->val.uld;
+    offset = elems[7]->val.uld;
+    len = elems[8]->array_len;
+
+    if( be->fragments == NULL )
+        be->fragments = new_empty_vector_t();
+
+    for( i = 0; i < be->fragments->size; i++ ) {
+        FragmentPartial_t* cur = (FragmentPartial_t*) be->fragments->vec[i];
+        if( (cur->origin == origin) && (cur->seq == seq) ) {
+            partial = cur;
+            break;
+        }
+    }
+
+    if( partial == NULL ) {
+        if( (offset != 0) || (total == 0) ) {
+            mrn_dbg( 1, mrn_printf(FLF, stderr, "fragment from %u at offset "
+                                   "%"PRIu64" does not start a packet\n",
+                                   origin, offset ));
+            return -1;
+        }
+        partial = (FragmentPartial_t*) calloc( (size_t)1, sizeof(FragmentPartial_t) );
+        if( partial == NULL )
+            return -1;
+        partial->buf = (char*) malloc( (size_t)total );
+        if( partial->buf == NULL ) {
+            free( partial );
+            return -1;
+        }
+        partial->origin = origin;
+        partial->seq = seq;
+        partial->len = total;
+        pushBackElement( be->fragments, partial );
+    }
+
+    if( (total != partial->len) || (offset != partial->received) ||
+        (len > partial->len - partial->received) ) {
+        mrn_dbg( 1, mrn_printf(FLF, stderr, "fragment from %u at offset "
+                               "%"PRIu64" out of order, dropping packet\n",
+                               origin, offset ));
+        eraseElement( be->fragments, partial );
+        free( partial->buf );
+        free( partial );
+        return -1;
+    }
+
+    if( len )
+        memcpy( partial->buf + partial->received, elems[8]->val.p, (size_t)len );
+    partial->received += len;
+
+    if( partial->received < partial->len )
+        return 0;
+
+    buf = partial->buf;
+    eraseElement( be->fragments, partial );
+    free( partial );
+
+    packet = new_Packet_t_4( ipacket->stream_id, tag, src, strdup(fmt),
+                             byteorder, total, buf, ipacket->inlet_rank );
+    if( packet == NULL ) {
+        mrn_dbg( 1, mrn_printf(FLF, stderr, "new_Packet_t_4() failed\n" ));
+        return -1;
+    }
+
+    mrn_dbg( 5, mrn_printf(FLF, stderr, "reassembled packet (stream:%u tag:%d "
+                           "len:%"PRIu64")\n", packet->stream_id, tag, total ));
+
+    return BackEndNode_proc_DataFromParent( be, packet );
+}
+
 int ChildNode_proc_NetworkSettings( BackEndNode_t* be, Packet_t* ipacket ) 
 {
     char* sg_byte_array = NULL;
@@ -29,6 +29,8 @@ int ChildNode_ack_DeleteSubTree(BackEndNode_t* be);
 
 int ChildNode_proc_NetworkSettings(BackEndNode_t* be, Packet_t* packet); 
 
+int ChildNode_proc_Fragment(BackEndNode_t* be, Packet_t* ipacket);
+
 int ChildNode_proc_RecoveryReport(BackEndNode_t* be, Packet_t* ipacket);
 
 int ChildNode_proc_EnablePerfData(BackEndNode_t* be, Packet_t* ipacket);
@@ -0,0 +1,110 @@
+/****************************************************************************
+ *  Copyright 2003-2015 Dorian C. Arnold, Philip C. Roth, Barton P. Miller  *
+ *                  Detailed MRNet usage rights in "LICENSE" file.          *
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "utils_lightweight.h"
+
+#include "mrnet_lightweight/HyperLogLog.h"
+
+/* the format of TFILTER_HYPERLOGLOG packets, see FilterDefinitions.C */
+static const char* HYPERLOGLOG_FORMATSTR = "%Auc";
+
+HyperLogLog_t* new_HyperLogLog_t(unsigned int iprecision)
+{
+    HyperLogLog_t* sketch;
+
+    if( (iprecision < 4) || (iprecision > 18) ) {
+        mrn_dbg(1, mrn_printf(FLF, stderr, "invalid precision %u, using 12\n",
+                              iprecision));
+        iprecision = 12;
+    }
+
+    sketch = (HyperLogLog_t*) calloc( (size_t)1, sizeof(HyperLogLog_t) );
+    if( sketch == NULL )
+        return NULL;
+
+    sketch->precision = iprecision;
+    sketch->registers = (unsigned char*) calloc( (size_t)1 << iprecision,
+                                                 sizeof(unsigned char) );
+    if( sketch->registers == NULL ) {
+        mrn_dbg(1, mrn_printf(FLF, stderr, "calloc() failed\n"));
+        free( sketch );
+        return NULL;
+    }
+    return sketch;
+}
+
+void delete_HyperLogLog_t(HyperLogLog_t* sketch)
+{
+    if( sketch == NULL )
+        return;
+    if( sketch->registers != NULL )
+        free( sketch->registers );
+    free( sketch );
+}
+
+void HyperLogLog_clear(HyperLogLog_t* sketch)
+{
+    memset( sketch->registers, 0, (size_t)1 << sketch->precision );
+}
+
+/* same as MRN::HyperLogLog's mix_Hash() */
+static uint64_t HyperLogLog_mix(uint64_t x)
+{
+    x += (uint64_t)0x9e3779b97f4a7c15ULL;
+    x = ( x ^ (x >> 30) ) * (uint64_t)0xbf58476d1ce4e5b9ULL;
+    x = ( x ^ (x >> 27) ) * (uint64_t)0x94d049bb133111ebULL;
+    return x ^ ( x >> 31 );
+}
+
+void HyperLogLog_add_Hash(HyperLogLog_t* sketch, uint64_t ihash)
+{
+    unsigned int p = sketch->precision;
+    size_t idx = (size_t)( ihash >> (64 - p) );
+    uint64_t w = ihash << p;
+    unsigned char rank = 1;
+
+    while( (rank <= 64 - p) && ! (w & ((uint64_t)1 << 63)) ) {
+        w <<= 1;
+        rank++;
+    }
+    if( rank > sketch->registers[idx] )
+        sketch->registers[idx] = rank;
+}
+
+void HyperLogLog_add(HyperLogLog_t* sketch, const void* idata, size_t ilen)
+{
+    /* FNV-1a, mixed to spread it over all 64 bits */
+    const unsigned char* bytes = (const unsigned char*) idata;
+    uint64_t h = (uint64_t)0xcbf29ce484222325ULL;
+    size_t i;
+
+    for( i = 0; i < ilen; i++ ) {
+        h ^= bytes[i];
+        h *= (uint64_t)0x100000001b3ULL;
+    }
+    HyperLogLog_add_Hash( sketch, HyperLogLog_mix(h) );
+}
+
+void HyperLogLog_add_String(HyperLogLog_t* sketch, const char* istr)
+{
+    if( istr != NULL )
+        HyperLogLog_add( sketch, istr, strlen(istr) );
+}
+
+void HyperLogLog_add_Value(HyperLogLog_t* sketch, uint64_t ivalue)
+{
+    HyperLogLog_add_Hash( sketch, HyperLogLog_mix(ivalue) );
+}
+
+int HyperLogLog_send(HyperLogLog_t* sketch, Stream_t* stream, int itag)
+{
+    uint64_t len = (uint64_t)1 << sketch->precision;
+
+    return Stream_send(stream, itag, HYPERLOGLOG_FORMATSTR,
+                       sketch->registers, len);
+}
@@ -24,11 +24,157 @@ Message_t* new_Message_t()
     assert(new_message);
     new_message->packet = (Packet_t*)malloc(sizeof(Packet_t));
     assert(new_message->packet);
+    Message_init(new_message, false);
 
     return new_message;
 }
 
-int Message_recv(XPlat_Socket sock_fd, vector_t* packets_in, Rank iinlet_rank)
+void Message_init(Message_t* msg, int ifmt_dict)
+{
+    msg->fmt_dict = ifmt_dict;
+    msg->sent_frame = false;
+    msg->send_fmts_len = 0;
+    msg->recv_fmts = NULL;
+    msg->recv_fmts_len = 0;
+    msg->recv_fmts_cap = 0;
+}
+
+bool_t Message_pdr_link_header(PDR* pdrs, LinkHeader_t* lhdr)
+{
+    uint64_t u;
+
+    if( ! pdr_varuint32(pdrs, &(lhdr->stream_id)) ||
+        ! pdr_varint32(pdrs, &(lhdr->tag)) ||
+        ! pdr_varuint32(pdrs, &(lhdr->src_rank)) ||
+        ! pdr_varuint32(pdrs, &(lhdr->fmt_code)) ) {
+        mrn_dbg(1, mrn_printf(FLF, stderr, "pdr_varuint32() failed\n"));
+        return false;
+    }
+
+    if( lhdr->fmt_code < FMT_CODE_FIRST_REF ) {
+        if( ! pdr_varstring(pdrs, &(lhdr->fmt_str), UINT32_MAX - 1) ) {
+            mrn_dbg(1, mrn_printf(FLF, stderr, "pdr_varstring() failed\n"));
+            return false;
+        }
+    }
+
+    if( ! pdr_varuint64(pdrs, &(lhdr->dest_arr_len)) ) {
+        mrn_dbg(1, mrn_printf(FLF, stderr, "pdr_varuint64() failed\n"));
+        return false;
+    }
+    if( lhdr->dest_arr_len ) {
+        if( pdrs->p_op == PDR_DECODE ) {
+            if( lhdr->dest_arr_len > UINT32_MAX )
+                return false;
+            lhdr->dest_arr = (Rank*) malloc( (size_t)lhdr->dest_arr_len * sizeof(Rank) );
+            if( lhdr->dest_arr == NULL )
+                return false;
+        }
+        for( u = 0; u < lhdr->dest_arr_len; u++ ) {
+            if( ! pdr_varuint32(pdrs, &(lhdr->dest_arr[u])) ) {
+                mrn_dbg(1, mrn_printf(FLF, stderr, "pdr_varuint32() failed\n"));
+                return false;
+            }
+        }
+    }
+
+    if( ! pdr_char(pdrs, &(lhdr->byteorder)) ) {
+        mrn_dbg(1, mrn_printf(FLF, stderr, "pdr_char() failed\n"));
+        return false;
+    }
+    return true;
+}
+
+/* fill in ohdr for sending ipacket, picking its format code */
+static void Message_encode_LinkHeader(Message_t* msg, Packet_t* ipacket,
+                                      LinkHeader_t* ohdr)
+{
+    unsigned int i;
+
+    ohdr->stream_id = ipacket->stream_id;
+    ohdr->tag = ipacket->tag;
+    ohdr->src_rank = ipacket->src_rank;
+    ohdr->fmt_code = FMT_CODE_LITERAL;
+    ohdr->fmt_str = ipacket->fmt_str;
+    ohdr->dest_arr_len = 0;
+    ohdr->dest_arr = NULL;
+    ohdr->byteorder = ipacket->byteorder;
+
+    if( ! msg->fmt_dict || ! msg->sent_frame || (ohdr->fmt_str == NULL) )
+        return;
+
+    for( i = 0; i < msg->send_fmts_len; i++ ) {
+        if( strcmp(msg->send_fmts[i], ohdr->fmt_str) == 0 ) {
+            ohdr->fmt_code = FMT_CODE_FIRST_REF + i;
+            ohdr->fmt_str = NULL;
+            return;
+        }
+    }
+    if( msg->send_fmts_len < MESSAGE_SEND_FMT_DICT_LEN ) {
+        msg->send_fmts[msg->send_fmts_len++] = strdup(ohdr->fmt_str);
+        ohdr->fmt_code = FMT_CODE_DEFINE;
+    }
+}
+
+/* decode the link header in ihdr and create the received packet, which
+   takes the ibuf payload. The header buffer is always freed */
+static Packet_t* Message_new_RecvPacket(Message_t* msg, char* ihdr, size_t ihdr_len,
+                                        char* ibuf, uint64_t ibuf_len,
+                                        Rank iinlet_rank)
+{
+    LinkHeader_t lhdr;
+    PDR pdrs;
+    bool_t ok;
+    size_t idx;
+    char** new_fmts;
+
+    memset(&lhdr, 0, sizeof(lhdr));
+    pdrmem_create(&pdrs, ihdr, (uint64_t)ihdr_len, PDR_DECODE, pdrmem_getbo());
+    ok = Message_pdr_link_header(&pdrs, &lhdr);
+    free(ihdr);
+
+    // destinations are only used for routing by internal processes
+    if( lhdr.dest_arr != NULL )
+        free(lhdr.dest_arr);
+
+    if( ok && (lhdr.fmt_code == FMT_CODE_DEFINE) ) {
+        ok = false;
+        if( (msg != NULL) && msg->fmt_dict &&
+            (msg->recv_fmts_len < FMT_DICT_MAX_ENTRIES) ) {
+            if( msg->recv_fmts_len == msg->recv_fmts_cap ) {
+                msg->recv_fmts_cap = ( msg->recv_fmts_cap ? msg->recv_fmts_cap * 2 : 16 );
+                new_fmts = (char**) realloc(msg->recv_fmts,
+                                            msg->recv_fmts_cap * sizeof(char*));
+                assert(new_fmts);
+                msg->recv_fmts = new_fmts;
+            }
+            msg->recv_fmts[msg->recv_fmts_len++] = strdup(lhdr.fmt_str);
+            ok = true;
+        }
+    }
+    else if( ok && (lhdr.fmt_code >= FMT_CODE_FIRST_REF) ) {
+        idx = (size_t)(lhdr.fmt_code - FMT_CODE_FIRST_REF);
+        if( (msg != NULL) && (idx < msg->recv_fmts_len) )
+            lhdr.fmt_str = strdup(msg->recv_fmts[idx]);
+        else
+            ok = false;
+    }
+
+    if( ! ok ) {
+        mrn_dbg(1, mrn_printf(FLF, stderr, "bad link header, format code %u\n",
+                              lhdr.fmt_code));
+        if( lhdr.fmt_str != NULL )
+            free(lhdr.fmt_str);
+        return NULL;
+    }
+
+    return new_Packet_t_4(lhdr.stream_id, lhdr.tag, lhdr.src_rank,
+                          lhdr.fmt_str, lhdr.byteorder,
+                          ibuf_len, ibuf, iinlet_rank);
+}
+
+int Message_recv(Message_t* msg_in, XPlat_Socket sock_fd, vector_t* packets_in,
+                 Rank iinlet_rank)
 {
     int retval;
     unsigned int i;
@@ -184,14 +330,16 @@ int Message_recv(XPlat_Socket sock_fd, vector_t* packets_in, Rank iinlet_rank)
     for( i = 0; i < num_buffers; i += 2 ) {
         mrn_dbg(5, mrn_printf(FLF, stderr, "creating packet[%d]\n",i));
 
-        new_packet = new_Packet_t_3( ncbufs[i].len, ncbufs[i].buf, 
-                                     ncbufs[i+1].len, ncbufs[i+1].buf, 
-                                     iinlet_rank );
+        new_packet = Message_new_RecvPacket( msg_in, ncbufs[i].buf, ncbufs[i].len,
+                                             ncbufs[i+1].buf, ncbufs[i+1].len,
+                                             iinlet_rank );
+        ncbufs[i].buf = NULL;
         if( new_packet == NULL ) {
             mrn_dbg(1, mrn_printf(FLF, stderr, "packet creation failed\n"));
             retval = -1;
             break;
         }   
+        ncbufs[i+1].buf = NULL;
 
         pushBackElement(packets_in, new_packet);
     }
@@ -226,6 +374,9 @@ int Message_send(Message_t* msg_out, XPlat_Socket sock_fd)
 
     XPlat_NCBuf_t ncbufs[2];
     uint64_t packet_sizes[2];
+    LinkHeader_t lhdr;
+    uint64_t hdr_len = 0;
+    char* hdr = NULL;
 
     mrn_dbg(3, mrn_printf(FLF, stderr, "Sending packets from message %p\n", msg_out));
 
@@ -246,8 +397,20 @@ int Message_send(Message_t* msg_out, XPlat_Socket sock_fd)
     num_packets = 1;
     num_buffers = num_packets * 2;
 
-    ncbufs[0].buf = msg_out->packet->hdr;
-    ncbufs[0].len = msg_out->packet->hdr_len;
+    Message_encode_LinkHeader(msg_out, msg_out->packet, &lhdr);
+    msg_out->sent_frame = true;
+    pdr_sizeof((pdrproc_t)(Message_pdr_link_header), &lhdr, &hdr_len);
+    hdr = (char*) malloc( (size_t)hdr_len );
+    assert(hdr);
+    pdrmem_create(&pdrs, hdr, hdr_len, op, pdrmem_getbo());
+    if( ! Message_pdr_link_header(&pdrs, &lhdr) ) {
+        mrn_dbg(1, mrn_printf(FLF, stderr, "Message_pdr_link_header() failed\n"));
+        free(hdr);
+        return -1;
+    }
+
+    ncbufs[0].buf = hdr;
+    ncbufs[0].len = (size_t)hdr_len;
     ncbufs[1].buf = msg_out->packet->buf;
     ncbufs[1].len = (size_t)msg_out->packet->buf_len;
     total_bytes = ncbufs[0].len + ncbufs[1].len;
@@ -269,6 +432,7 @@ int Message_send(Message_t* msg_out, XPlat_Socket sock_fd)
     if( ! pdr_uint32(&pdrs, &num_packets) ) {
         mrn_dbg( 1, mrn_printf(FLF, stderr, "pdr_uint32() failed\n") );
         free(buf);
+        free(hdr);
         return -1;
     }
     buf[0] = (char) pdrmem_getbo();
@@ -277,6 +441,7 @@ int Message_send(Message_t* msg_out, XPlat_Socket sock_fd)
     if( mcwret != (ssize_t)buf_len + 1) {
         mrn_dbg(1, mrn_printf(FLF, stderr, "MRN_send() failed\n"));
         free(buf);
+        free(hdr);
         return -1;
     }
     mrn_dbg(5, mrn_printf(FLF, stderr, "MRN_send() succeeded\n"));
@@ -295,6 +460,7 @@ int Message_send(Message_t* msg_out, XPlat_Socket sock_fd)
                      (uint64_t) sizeof(uint64_t), (pdrproc_t) pdr_uint64) ) {
         mrn_dbg(1, mrn_printf(FLF, stderr, "pdr_vector() failed\n"));
         free(buf);
+        free(hdr);
         return -1;
     }
 
@@ -304,6 +470,7 @@ int Message_send(Message_t* msg_out, XPlat_Socket sock_fd)
     if( mcwret != (ssize_t)buf_len ) {
         mrn_dbg(1, mrn_printf(FLF, stderr, "MRN_send failed\n"));
         free(buf);
+        free(hdr);
         return -1;
     }
     free(buf);
@@ -323,8 +490,10 @@ int Message_send(Message_t* msg_out, XPlat_Socket sock_fd)
                               "XPlat_SocketUtils_Send() returned %d of %d bytes,"
                               " errno = %d, nbuffers = %d\n", 
                               sret, total_bytes, err, num_packets));
+        free(hdr);
         return -1;
     }
+    free(hdr);
 
     if( go_away )
         XPlat_SocketUtils_Close(sock_fd);
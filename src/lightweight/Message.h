@@ -19,15 +19,48 @@
 #include <sys/socket.h>
 #endif
 
+/* entries of the send format dictionary, which is searched linearly */
+#define MESSAGE_SEND_FMT_DICT_LEN 64
+
 typedef struct {
    Packet_t* packet;
+
+   /* link format dictionaries (see FormatCodes in Protocol.h), used by
+      the Messages that stay with one end of a data link. The first frame
+      sent never defines entries, as the parent reads it before the
+      link's Message exists */
+   int fmt_dict;
+   int sent_frame;
+   char* send_fmts[MESSAGE_SEND_FMT_DICT_LEN];
+   unsigned int send_fmts_len;
+   char** recv_fmts;
+   unsigned int recv_fmts_len;
+   unsigned int recv_fmts_cap;
 } Message_t ;
 
+/* packet header as sent on a link: varint encoded packet header fields,
+   with the format string replaced by a format code */
+typedef struct {
+   uint32_t stream_id;
+   int32_t tag;
+   Rank src_rank;
+   uint32_t fmt_code;
+   char* fmt_str;          /* NULL for dictionary references */
+   uint64_t dest_arr_len;
+   Rank* dest_arr;
+   char byteorder;         /* of the packet data buffer */
+} LinkHeader_t;
+
 Message_t* new_Message_t();
+void Message_init(Message_t* msg, int ifmt_dict);
 
-int Message_recv(XPlat_Socket sock_fd, vector_t* packets_in, Rank iinlet_rank);
+/* msg_in may be NULL on links without a format dictionary */
+int Message_recv(Message_t* msg_in, XPlat_Socket sock_fd, vector_t* packets_in,
+                 Rank iinlet_rank);
 int Message_send(Message_t* msg_out, XPlat_Socket sock_fd);
 
+bool_t Message_pdr_link_header(PDR* pdrs, LinkHeader_t* lhdr);
+
 ssize_t MRN_send(XPlat_Socket sock_fd, void *buf, size_t buf_len);
 ssize_t MRN_recv(XPlat_Socket sock_fd, void *buf, size_t count);
 
@@ -12,6 +12,8 @@
 #include "mrnet_lightweight/Packet.h"
 #include "xplat_lightweight/vector.h"
 
+static Packet_t* Packet_decode_data(Packet_t* packet);
+
 void delete_Packet_t(Packet_t* packet)
 {
     unsigned int i;
@@ -178,6 +180,45 @@ Packet_t* new_Packet_t_3(unsigned int ihdr_len, char* ihdr,
         error(ERR_PACKING,UnknownRank, "pdr_packet() failed\n");
     }
 
+    return Packet_decode_data( packet );
+}
+
+Packet_t* new_Packet_t_4(uint32_t istream_id, int32_t itag, Rank isrc,
+                         char* ifmt_str, char ibyteorder,
+                         uint64_t ibuf_len, char* ibuf,
+                         Rank iinlet_rank)
+{
+    Packet_t* packet;
+
+    mrn_dbg_func_begin();
+
+    // initialize packet
+    packet = (Packet_t*) calloc( (size_t)1, sizeof(Packet_t) );
+    if( packet == NULL ) {
+        mrn_dbg(1, mrn_printf(FLF, stderr, "calloc() failed\n"));
+        return NULL;
+    }
+
+    packet->stream_id = istream_id;
+    packet->tag = itag;
+    packet->src_rank = isrc;
+    packet->fmt_str = ifmt_str;
+    packet->byteorder = ibyteorder;
+    packet->hdr = NULL;
+    packet->hdr_len = 0;
+    packet->buf = ibuf;
+    packet->buf_len = ibuf_len;
+    packet->inlet_rank = iinlet_rank;
+    packet->data_elements = new_empty_vector_t();
+
+    return Packet_decode_data( packet );
+}
+
+/* decodes the data elements of a received packet */
+static Packet_t* Packet_decode_data(Packet_t* packet)
+{
+    PDR pdrs;
+
     mrn_dbg(3, mrn_printf(FLF, stderr,  
                           "Packet(%p): stream:%d tag:%d fmt:'%s'\n", 
                           packet, packet->stream_id, packet->tag, packet->fmt_str));
@@ -28,6 +28,8 @@ PeerNode_t* new_PeerNode_t(Network_t* inetwork,
   peer_node->is_internal_node = is_internal_node;
   peer_node->is_parent = is_parent;
   peer_node->available = true;
+  Message_init(&(peer_node->msg_out), true);
+  Message_init(&(peer_node->msg_in), true);
 
 #ifdef MRNET_LTWT_THREADSAFE  
     peer_node->send_mutex = Mutex_construct();
@@ -252,7 +254,7 @@ int PeerNode_recv_event(PeerNode_t* node, vector_t* packet_list, bool_t blocking
 {
     int msg_ret = 0; 
     if(  PeerNode_has_event_data(node) ) {
-        msg_ret = Message_recv(node->event_sock_fd, packet_list, node->rank);
+        msg_ret = Message_recv(NULL, node->event_sock_fd, packet_list, node->rank);
     }
     blocking = 1;
     return msg_ret;
@@ -267,7 +269,7 @@ int PeerNode_recv(PeerNode_t* node, vector_t* packet_list, bool_t blocking)
         return msg_ret;
     }
     if( blocking || PeerNode_has_data(node) ) {
-        msg_ret = Message_recv(node->data_sock_fd, packet_list, node->rank);
+        msg_ret = Message_recv(&(node->msg_in), node->data_sock_fd, packet_list, node->rank);
     }
 
     PeerNode_recv_unlock(node);
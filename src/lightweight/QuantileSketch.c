@@ -0,0 +1,143 @@
+/****************************************************************************
+ *  Copyright 2003-2015 Dorian C. Arnold, Philip C. Roth, Barton P. Miller  *
+ *                  Detailed MRNet usage rights in "LICENSE" file.          *
+ ****************************************************************************/
+
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "utils_lightweight.h"
+
+#include "mrnet_lightweight/QuantileSketch.h"
+
+/* the format of TFILTER_QUANTILE_SKETCH packets, see FilterDefinitions.C */
+static const char* QUANTILE_SKETCH_FORMATSTR = "%lf %ud %d %auld %uld %lf %lf %lf";
+
+QuantileSketch_t* new_QuantileSketch_t(double irelative_accuracy,
+                                       unsigned int imax_buckets)
+{
+    QuantileSketch_t* sketch;
+
+    if( ! ((irelative_accuracy > 0.0) && (irelative_accuracy < 1.0)) ) {
+        mrn_dbg(1, mrn_printf(FLF, stderr, "invalid relative accuracy %lf, "
+                              "using 0.01\n", irelative_accuracy));
+        irelative_accuracy = 0.01;
+    }
+
+    sketch = (QuantileSketch_t*) calloc( (size_t)1, sizeof(QuantileSketch_t) );
+    if( sketch == NULL )
+        return NULL;
+
+    sketch->relative_accuracy = irelative_accuracy;
+    sketch->log_gamma = log( (1.0 + irelative_accuracy) / (1.0 - irelative_accuracy) );
+    sketch->max_buckets = ( imax_buckets ? imax_buckets : 1 );
+    QuantileSketch_clear( sketch );
+    return sketch;
+}
+
+void delete_QuantileSketch_t(QuantileSketch_t* sketch)
+{
+    if( sketch == NULL )
+        return;
+    if( sketch->counts != NULL )
+        free( sketch->counts );
+    free( sketch );
+}
+
+void QuantileSketch_clear(QuantileSketch_t* sketch)
+{
+    if( sketch->counts != NULL )
+        free( sketch->counts );
+    sketch->counts = NULL;
+    sketch->num_counts = 0;
+    sketch->offset = 0;
+    sketch->zero_count = 0;
+    sketch->count = 0;
+    sketch->min = sketch->max = sketch->sum = 0.0;
+}
+
+/* makes the buckets cover 'ikey' as well, merging the lowest ones into the
+   first if that takes too many. Returns -1 if out of memory */
+static int QuantileSketch_extend(QuantileSketch_t* sketch, int ikey)
+{
+    int low = ikey, high = ikey;
+    uint32_t i, new_size;
+    uint64_t* counts;
+
+    if( sketch->num_counts ) {
+        int cur_high = sketch->offset + (int)sketch->num_counts - 1;
+        if( sketch->offset < low )
+            low = sketch->offset;
+        if( cur_high > high )
+            high = cur_high;
+    }
+    if( (int64_t)high - low + 1 > (int64_t)sketch->max_buckets )
+        low = high - (int)sketch->max_buckets + 1;
+
+    new_size = (uint32_t)( high - low + 1 );
+    counts = (uint64_t*) calloc( (size_t)new_size, sizeof(uint64_t) );
+    if( counts == NULL ) {
+        mrn_dbg(1, mrn_printf(FLF, stderr, "calloc() failed\n"));
+        return -1;
+    }
+    for( i = 0; i < sketch->num_counts; i++ ) {
+        int key = sketch->offset + (int)i;
+        counts[ key > low ? key - low : 0 ] += sketch->counts[i];
+    }
+
+    if( sketch->counts != NULL )
+        free( sketch->counts );
+    sketch->counts = counts;
+    sketch->num_counts = new_size;
+    sketch->offset = low;
+    return 0;
+}
+
+void QuantileSketch_add(QuantileSketch_t* sketch, double ivalue, uint64_t icount)
+{
+    if( (icount == 0) || ! ((ivalue >= -DBL_MAX) && (ivalue <= DBL_MAX)) )
+        return; /* NaN or infinite */
+
+    if( ivalue > 0.0 ) {
+        /* same bucket as MRN::QuantileSketch::get_Key() */
+        int key = (int) ceil( log(ivalue) / sketch->log_gamma );
+        if( (sketch->num_counts == 0) || (key < sketch->offset) ||
+            (key >= sketch->offset + (int)sketch->num_counts) ) {
+            if( QuantileSketch_extend(sketch, key) == -1 )
+                return;
+        }
+        sketch->counts[ key > sketch->offset ? key - sketch->offset : 0 ] += icount;
+    }
+    else
+        sketch->zero_count += icount;
+
+    if( sketch->count == 0 )
+        sketch->min = sketch->max = ivalue;
+    else if( ivalue < sketch->min )
+        sketch->min = ivalue;
+    else if( ivalue > sketch->max )
+        sketch->max = ivalue;
+    sketch->count += icount;
+    sketch->sum += ivalue * (double)icount;
+}
+
+int QuantileSketch_send(QuantileSketch_t* sketch, Stream_t* stream, int itag)
+{
+    uint64_t zero = 0;
+    uint32_t first = 0, last = sketch->num_counts;
+
+    /* only the range of non-empty buckets is sent */
+    while( (first < last) && (sketch->counts[first] == 0) )
+        first++;
+    while( (last > first) && (sketch->counts[last - 1] == 0) )
+        last--;
+
+    return Stream_send(stream, itag, QUANTILE_SKETCH_FORMATSTR,
+                       sketch->relative_accuracy, sketch->max_buckets,
+                       sketch->offset + (int)first,
+                       ( last > first ? sketch->counts + first : &zero ),
+                       last - first, sketch->zero_count,
+                       sketch->min, sketch->max, sketch->sum);
+}
@@ -0,0 +1,181 @@
+/****************************************************************************
+ *  Copyright 2003-2015 Dorian C. Arnold, Philip C. Roth, Barton P. Miller  *
+ *                  Detailed MRNet usage rights in "LICENSE" file.          *
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "utils_lightweight.h"
+
+#include "mrnet_lightweight/TopKSketch.h"
+
+/* the format of TFILTER_TOP_K packets, see FilterDefinitions.C */
+static const char* TOP_K_FORMATSTR = "%ud %ud %ud %auld %auld %uld";
+
+TopKSketch_t* new_TopKSketch_t(unsigned int ik, unsigned int iwidth,
+                               unsigned int idepth)
+{
+    TopKSketch_t* sketch;
+
+    sketch = (TopKSketch_t*) calloc( (size_t)1, sizeof(TopKSketch_t) );
+    if( sketch == NULL )
+        return NULL;
+
+    sketch->k = ( ik ? ik : 1 );
+    sketch->width = ( iwidth ? iwidth : 1 );
+    sketch->depth = ( idepth ? idepth : 1 );
+    sketch->counters = (uint64_t*) calloc( (size_t)sketch->width * sketch->depth,
+                                           sizeof(uint64_t) );
+    sketch->heap = (TopKCandidate_t*) calloc( (size_t)sketch->k,
+                                              sizeof(TopKCandidate_t) );
+    if( (sketch->counters == NULL) || (sketch->heap == NULL) ) {
+        mrn_dbg(1, mrn_printf(FLF, stderr, "calloc() failed\n"));
+        delete_TopKSketch_t( sketch );
+        return NULL;
+    }
+    return sketch;
+}
+
+void delete_TopKSketch_t(TopKSketch_t* sketch)
+{
+    if( sketch == NULL )
+        return;
+    if( sketch->counters != NULL )
+        free( sketch->counters );
+    if( sketch->heap != NULL )
+        free( sketch->heap );
+    free( sketch );
+}
+
+void TopKSketch_clear(TopKSketch_t* sketch)
+{
+    memset( sketch->counters, 0,
+            (size_t)sketch->width * sketch->depth * sizeof(uint64_t) );
+    sketch->total = 0;
+    sketch->num_candidates = 0;
+}
+
+/* same as MRN::TopKSketch's get_Hash() */
+static uint64_t TopKSketch_hash(uint64_t ikey, unsigned int irow)
+{
+    uint64_t x = ikey + (uint64_t)( irow + 1 ) * (uint64_t)0x9e3779b97f4a7c15ULL;
+    x ^= x >> 33;
+    x *= (uint64_t)0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= (uint64_t)0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+/* restores the heap below slot 'i' after its estimate grew */
+static void TopKSketch_sift_down(TopKSketch_t* sketch, unsigned int i)
+{
+    TopKCandidate_t* heap = sketch->heap;
+    TopKCandidate_t tmp;
+    unsigned int smallest, child;
+
+    for( ;; ) {
+        smallest = i;
+        child = 2 * i + 1;
+        if( (child < sketch->num_candidates) &&
+            (heap[child].estimate < heap[smallest].estimate) )
+            smallest = child;
+        child++;
+        if( (child < sketch->num_candidates) &&
+            (heap[child].estimate < heap[smallest].estimate) )
+            smallest = child;
+        if( smallest == i )
+            return;
+        tmp = heap[i];
+        heap[i] = heap[smallest];
+        heap[smallest] = tmp;
+        i = smallest;
+    }
+}
+
+static void TopKSketch_sift_up(TopKSketch_t* sketch, unsigned int i)
+{
+    TopKCandidate_t* heap = sketch->heap;
+    TopKCandidate_t tmp;
+    unsigned int parent;
+
+    while( i > 0 ) {
+        parent = (i - 1) / 2;
+        if( heap[parent].estimate <= heap[i].estimate )
+            return;
+        tmp = heap[i];
+        heap[i] = heap[parent];
+        heap[parent] = tmp;
+        i = parent;
+    }
+}
+
+void TopKSketch_add(TopKSketch_t* sketch, uint64_t ikey, uint64_t icount)
+{
+    uint64_t estimate = 0;
+    uint64_t* c;
+    unsigned int r, i;
+
+    if( icount == 0 )
+        return;
+
+    for( r = 0; r < sketch->depth; r++ ) {
+        c = sketch->counters + (size_t)r * sketch->width
+            + TopKSketch_hash(ikey, r) % sketch->width;
+        *c += icount;
+        if( (r == 0) || (*c < estimate) )
+            estimate = *c;
+    }
+    sketch->total += icount;
+
+    /* keys lighter than every candidate cannot be one already */
+    if( (sketch->num_candidates == sketch->k) &&
+        (estimate <= sketch->heap[0].estimate) )
+        return;
+
+    for( i = 0; i < sketch->num_candidates; i++ ) {
+        if( sketch->heap[i].key == ikey ) {
+            sketch->heap[i].estimate = estimate;
+            TopKSketch_sift_down( sketch, i );
+            return;
+        }
+    }
+
+    if( sketch->num_candidates < sketch->k ) {
+        i = sketch->num_candidates++;
+        sketch->heap[i].key = ikey;
+        sketch->heap[i].estimate = estimate;
+        TopKSketch_sift_up( sketch, i );
+    }
+    else {
+        /* replace the lightest candidate */
+        sketch->heap[0].key = ikey;
+        sketch->heap[0].estimate = estimate;
+        TopKSketch_sift_down( sketch, 0 );
+    }
+}
+
+int TopKSketch_send(TopKSketch_t* sketch, Stream_t* stream, int itag)
+{
+    int ret;
+    unsigned int i;
+    uint64_t* keys;
+
+    keys = (uint64_t*) malloc( (size_t)(sketch->num_candidates ? sketch->num_candidates : 1)
+                               * sizeof(uint64_t) );
+    if( keys == NULL ) {
+        mrn_dbg(1, mrn_printf(FLF, stderr, "malloc() failed\n"));
+        return -1;
+    }
+    for( i = 0; i < sketch->num_candidates; i++ )
+        keys[i] = sketch->heap[i].key;
+
+    ret = Stream_send(stream, itag, TOP_K_FORMATSTR,
+                      sketch->k, sketch->width, sketch->depth,
+                      sketch->counters, (uint32_t)(sketch->width * sketch->depth),
+                      keys, (uint32_t)sketch->num_candidates,
+                      sketch->total);
+    free( keys );
+    return ret;
+}
@@ -126,6 +126,77 @@ bool_t pdr_double(PDR *pdrs, double *ip)
     return FALSE;
 }
 
+/*
+ * PDR variable-length unsigned integers
+ * Seven value bits per byte, least significant group first, with the high
+ * bit set on all but the last byte. The encoding does not depend on the
+ * stream byte order, and small values take a single byte.
+ */
+bool_t pdr_varuint64(PDR *pdrs, uint64_t *up)
+{
+    uint64_t val;
+    unsigned int shift;
+    char c;
+
+    switch (pdrs->p_op) {
+    case PDR_FREE:
+        return TRUE;
+    case PDR_ENCODE:
+        val = *up;
+        do {
+            c = (char)(val & 0x7f);
+            val >>= 7;
+            if (val)
+                c |= (char)0x80;
+            if (! pdr_putchar(pdrs, &c))
+                return FALSE;
+        } while (val);
+        return TRUE;
+    case PDR_DECODE:
+        val = 0;
+        for (shift = 0; shift < 64; shift += 7) {
+            if (! pdr_getchar(pdrs, &c))
+                return FALSE;
+            val |= ((uint64_t)(c & 0x7f)) << shift;
+            if (! (c & 0x80)) {
+                *up = val;
+                return TRUE;
+            }
+        }
+        return FALSE;
+    }
+    return FALSE;
+}
+
+bool_t pdr_varuint32(PDR *pdrs, uint32_t *up)
+{
+    uint64_t val = *up;
+
+    if (! pdr_varuint64(pdrs, &val))
+        return FALSE;
+    if (pdrs->p_op == PDR_DECODE) {
+        if (val > (uint64_t)LASTUNSIGNED)
+            return FALSE;
+        *up = (uint32_t)val;
+    }
+    return TRUE;
+}
+
+/*
+ * PDR variable-length signed integers, zigzag mapped so that values
+ * near zero take a single byte
+ */
+bool_t pdr_varint32(PDR *pdrs, int32_t *ip)
+{
+    uint32_t zz = ((uint32_t)*ip << 1) ^ (uint32_t)(*ip >> 31);
+
+    if (! pdr_varuint32(pdrs, &zz))
+        return FALSE;
+    if (pdrs->p_op == PDR_DECODE)
+        *ip = (int32_t)(zz >> 1) ^ -(int32_t)(zz & 1);
+    return TRUE;
+}
+
 /*
  * PDR booleans
  */
@@ -332,6 +403,47 @@ bool_t pdr_wrapstring(PDR *pdrs, char **cpp)
     return pdr_string(pdrs, cpp, LASTUNSIGNED-1);
 }
 
+/*
+ * PDR null terminated strings with a variable-length count, which does
+ * not include the terminator. A NULL string is encoded as empty.
+ */
+bool_t pdr_varstring(PDR *pdrs, char **cpp, uint32_t maxsize)
+{
+    char *sp = *cpp;
+    uint32_t len = 0;
+
+    switch (pdrs->p_op) {
+    case PDR_FREE:
+        if (sp != NULL) {
+            free(sp);
+            *cpp = NULL;
+        }
+        return TRUE;
+    case PDR_ENCODE:
+        if (sp != NULL)
+            len = (uint32_t)strlen(sp);
+        break;
+    case PDR_DECODE:
+        break;
+    }
+
+    if (! pdr_varuint32(pdrs, &len))
+        return FALSE;
+    if (len > maxsize)
+        return FALSE;
+
+    if (pdrs->p_op == PDR_DECODE) {
+        if (sp == NULL) {
+            sp = (char*) malloc((size_t)len + 1);
+            if (sp == NULL)
+                return FALSE;
+            *cpp = sp;
+        }
+        sp[len] = '\0';
+    }
+    return pdr_opaque(pdrs, sp, len);
+}
+
 /*
  * PDR an indirect pointer
  * pdr_reference is for recursively translating a structure that is
@@ -405,6 +517,106 @@ bool_t pdr_pointer(PDR *pdrs, char **objpp, uint32_t obj_size, pdrproc_t pdr_obj
     return (pdr_reference(pdrs,objpp,obj_size,pdr_obj));
 }
  
+/*
+ * Returns the encoded element size if elements handled by 'elproc' are
+ * plain scalars of 'elsize' bytes that can be transferred in bulk,
+ * otherwise 0.
+ */
+static uint32_t pdr_bulk_elsize(pdrproc_t elproc, uint64_t elsize)
+{
+    uint32_t sz = 0;
+
+    if( (elproc == (pdrproc_t) pdr_char) ||
+        (elproc == (pdrproc_t) pdr_uchar) )
+        sz = SIZEOF_CHAR;
+    else if( (elproc == (pdrproc_t) pdr_int16) ||
+             (elproc == (pdrproc_t) pdr_uint16) )
+        sz = SIZEOF_INT16;
+    else if( (elproc == (pdrproc_t) pdr_int32) ||
+             (elproc == (pdrproc_t) pdr_uint32) )
+        sz = SIZEOF_INT32;
+    else if( (elproc == (pdrproc_t) pdr_int64) ||
+             (elproc == (pdrproc_t) pdr_uint64) )
+        sz = SIZEOF_INT64;
+    else if( elproc == (pdrproc_t) pdr_float )
+        sz = SIZEOF_FLOAT;
+    else if( elproc == (pdrproc_t) pdr_double )
+        sz = SIZEOF_DOUBLE;
+
+    if( (uint64_t)sz != elsize )
+        return 0;
+    return sz;
+}
+
+/*
+ * PDR a contiguous run of nelem fixed-size scalars of elsize bytes each,
+ * e.g. the elements of an int32_t or double array. This replaces a call
+ * to the element procedure per element with a single copy, which swaps
+ * byte order as needed on decode.
+ */
+bool_t pdr_bulk(PDR *pdrs, char *basep, uint64_t nelem, uint32_t elsize)
+{
+    if (nelem == 0) {
+        return TRUE;
+    }
+
+    switch (pdrs->p_op) {
+    case PDR_DECODE:
+        return pdr_getvector(pdrs, basep, nelem, elsize);
+    case PDR_ENCODE:
+        return pdr_putvector(pdrs, basep, nelem, elsize);
+    case PDR_FREE:
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+/*
+ * PDR an array like pdr_array(), but on decode try to avoid the copy.
+ * If *addrp is NULL, the elements are plain scalars, and the stream holds
+ * them in local byte order at a suitably aligned address, *addrp is set
+ * to point into the stream's buffer and *inlinep to TRUE. Such an array
+ * must not be freed and is only valid as long as the buffer.
+ */
+bool_t pdr_array_inline(PDR *pdrs, void **addrp, uint64_t *sizep, uint64_t maxsize,
+                        uint32_t elsize, pdrproc_t elproc, bool_t *inlinep)
+{
+    uint64_t pos, c;
+    char * p;
+
+    *inlinep = FALSE;
+    if ((pdrs->p_op != PDR_DECODE) || (*addrp != NULL) ||
+        (pdr_bulk_elsize(elproc, elsize) == 0)) {
+        return pdr_array(pdrs, addrp, sizep, maxsize, elsize, elproc);
+    }
+
+    pos = pdr_getpos(pdrs);
+    if (! pdr_uint64(pdrs, sizep)) {
+        return (FALSE);
+    }
+    c = *sizep;
+    if ((c > maxsize) || (c > UINT64_MAX / elsize)) {
+        return (FALSE);
+    }
+    if (c == 0) {
+        return (TRUE);
+    }
+
+    p = pdr_getinline(pdrs, c * elsize, elsize);
+    if (p != NULL) {
+        *addrp = p;
+        *inlinep = TRUE;
+        return (TRUE);
+    }
+
+    /* byte order or alignment does not allow it, so decode a copy */
+    if (! pdr_setpos(pdrs, pos)) {
+        return (FALSE);
+    }
+    return pdr_array(pdrs, addrp, sizep, maxsize, elsize, elproc);
+}
+
 /*
  * PDR an array of arbitrary elements
  * *addrp is a pointer to the array, *sizep is the number of elements.
@@ -420,6 +632,7 @@ bool_t pdr_array(PDR *pdrs, void **addrp, uint64_t *sizep, uint64_t maxsize,
     uint64_t c;  /* the actual element count */
     bool_t rc = TRUE;
     uint64_t nodesize;
+    uint32_t bulk_elsize = pdr_bulk_elsize(elproc, elsize);
  
     /* like strings, arrays are really counted arrays */
     if (! pdr_uint64(pdrs, sizep)) {
@@ -440,7 +653,12 @@ bool_t pdr_array(PDR *pdrs, void **addrp, uint64_t *sizep, uint64_t maxsize,
         case PDR_DECODE:
             if (c == 0)
                 return (TRUE);
-            *addrp = calloc((size_t)nodesize, sizeof(char));
+            /* scalars will be overwritten by the bulk copy, other
+               elements must start out zeroed */
+            if (bulk_elsize)
+                *addrp = malloc((size_t)nodesize);
+            else
+                *addrp = calloc((size_t)nodesize, sizeof(char));
             target = (char*) *addrp;
             if (target == NULL) {
                 return (FALSE);
@@ -454,11 +672,16 @@ bool_t pdr_array(PDR *pdrs, void **addrp, uint64_t *sizep, uint64_t maxsize,
     }
         
     /*
-     * now we pdr each element of array
+     * now we pdr each element of array, or all of them at once
      */
-    for (i = 0; (i < c) && rc; i++) {
-        rc = (*elproc)(pdrs, target);
-        target += elsize;
+    if (bulk_elsize && (pdrs->p_op != PDR_FREE)) {
+        rc = pdr_bulk(pdrs, target, c, bulk_elsize);
+    }
+    else {
+        for (i = 0; (i < c) && rc; i++) {
+            rc = (*elproc)(pdrs, target);
+            target += elsize;
+        }
     }
 
     /*
@@ -486,6 +709,11 @@ bool_t pdr_vector(PDR *pdrs, char *basep, uint64_t nelem, uint64_t elemsize,
 {
     uint64_t i;
     char *elptr;
+    uint32_t bulk_elsize = pdr_bulk_elsize(pdr_elem, elemsize);
+
+    if (bulk_elsize) {
+        return pdr_bulk(pdrs, basep, nelem, bulk_elsize);
+    }
 
     elptr = basep;
     for (i = 0; i < nelem; i++) {
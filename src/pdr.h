@@ -95,6 +95,9 @@ struct pdr_ops {
     bool_t  (*getdouble)(PDR *pdrs, double *dp);
     bool_t  (*putbytes)(PDR *pdrs, char *, uint64_t);
     bool_t  (*getbytes)(PDR *pdrs, char *, uint64_t);
+    bool_t  (*putvector)(PDR *pdrs, char *, uint64_t nelem, uint32_t elsize);
+    bool_t  (*getvector)(PDR *pdrs, char *, uint64_t nelem, uint32_t elsize);
+    char *  (*getinline)(PDR *pdrs, uint64_t len, uint32_t align);
     bool_t  (*setpos)(PDR *pdrs, uint64_t ip);
     uint64_t (*getpos)(PDR *pdrs);
     void    (*destroy)(PDR *pdrs);
@@ -136,6 +139,10 @@ extern bool_t   pdr_uint64(PDR *pdrs, uint64_t *ip);
 extern bool_t   pdr_float(PDR *pdrs, float *ip);
 extern bool_t   pdr_double(PDR *pdrs, double *ip);
 
+extern bool_t   pdr_varuint32(PDR *pdrs, uint32_t *up);
+extern bool_t   pdr_varint32(PDR *pdrs, int32_t *ip);
+extern bool_t   pdr_varuint64(PDR *pdrs, uint64_t *up);
+
 extern bool_t   pdr_bool(PDR *pdrs, bool_t *bp);
 extern bool_t   pdr_enum(PDR *pdrs, enum_t *bp);
 
@@ -144,6 +151,7 @@ extern bool_t   pdr_bytes(PDR *pdrs, char **cpp, uint64_t *sizep,
                           uint64_t maxsize);
 extern bool_t   pdr_string(PDR *pdrs, char **cpp, uint32_t maxsize);
 extern bool_t   pdr_wrapstring(PDR *pdrs, char **cpp);
+extern bool_t   pdr_varstring(PDR *pdrs, char **cpp, uint32_t maxsize);
 extern bool_t   pdr_reference(PDR *pdrs, char **pp, uint32_t size,
                               pdrproc_t proc);
 extern bool_t   pdr_pointer(PDR *pdrs, char **objpp, uint32_t obj_size,
@@ -153,6 +161,11 @@ extern bool_t   pdr_array(PDR *pdrs, void **addrp, uint64_t *sizep,
                           uint64_t maxsize, uint32_t elsize, pdrproc_t elproc);
 extern bool_t   pdr_vector(PDR *pdrs, char *basep, uint64_t nelem,
                           uint64_t elemsize, pdrproc_t pdr_elem);
+extern bool_t   pdr_bulk(PDR *pdrs, char *basep, uint64_t nelem,
+                         uint32_t elsize);
+extern bool_t   pdr_array_inline(PDR *pdrs, void **addrp, uint64_t *sizep,
+                                 uint64_t maxsize, uint32_t elsize,
+                                 pdrproc_t elproc, bool_t *inlinep);
 
 
 /*
@@ -260,6 +273,14 @@ extern pdr_byteorder pdrmem_getbo(void);  // Get local machine byte ordering (us
 #define pdr_putbytes(pdrs, addr, len)                        \
         (*(pdrs)->p_ops->putbytes)(pdrs, addr, len)
 
+#define pdr_getvector(pdrs, addr, nelem, elsize)                \
+        (*(pdrs)->p_ops->getvector)(pdrs, addr, nelem, elsize)
+#define pdr_putvector(pdrs, addr, nelem, elsize)                \
+        (*(pdrs)->p_ops->putvector)(pdrs, addr, nelem, elsize)
+
+#define pdr_getinline(pdrs, len, align)                         \
+        (*(pdrs)->p_ops->getinline)(pdrs, len, align)
+
 #define pdr_getpos(pdrs)                                \
         (*(pdrs)->p_ops->getpos)(pdrs)
 #define pdr_setpos(pdrs, pos)                           \
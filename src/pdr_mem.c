@@ -342,6 +342,92 @@ static bool_t pdrmem_putbytes(PDR *pdrs, char *addr,  uint64_t len)
     return TRUE;
 }
 
+/*
+ *  pdrmem_xxxvector(): Procedures for putting/getting arrays of 'nelem'
+ *  fixed-size scalars of 'elsize' bytes each. Data is encoded in local
+ *  byte order, so only a decode from a different byte order has to swap.
+ */
+static bool_t pdrmem_putvector(PDR *pdrs, char *addr, uint64_t nelem, uint32_t elsize)
+{
+    uint64_t len = nelem * elsize;
+
+    if( (elsize == 0) || (nelem > pdrs->space / elsize) ) {
+        return FALSE;
+    }
+    assert(pdrs->p_op == PDR_ENCODE);
+
+    memcpy(pdrs->cur, addr, (size_t)len);
+
+    pdrs->cur += len;
+    pdrs->space -= len;
+    return TRUE;
+}
+
+static bool_t pdrmem_getvector(PDR *pdrs, char *addr, uint64_t nelem, uint32_t elsize)
+{
+    uint64_t len = nelem * elsize;
+
+    if( (elsize == 0) || (nelem > pdrs->space / elsize) ) {
+        mrn_dbg(1, mrn_printf(FLF, stderr, "Not enough data left: %" PRIu64"\n",
+                              pdrs->space ));
+        return FALSE;
+    }
+    assert(pdrs->p_op == PDR_DECODE);
+
+    memcpy(addr, pdrs->cur, (size_t)len);
+
+    pdrs->cur += len;
+    pdrs->space -= len;
+    return TRUE;
+}
+
+static bool_t pdrmem_getvector_swap(PDR *pdrs, char *addr, uint64_t nelem, uint32_t elsize)
+{
+    uint64_t len = nelem * elsize;
+
+    if( (elsize == 0) || (nelem > pdrs->space / elsize) ) {
+        mrn_dbg(1, mrn_printf(FLF, stderr, "Not enough data left: %" PRIu64"\n",
+                              pdrs->space ));
+        return FALSE;
+    }
+    assert(pdrs->p_op == PDR_DECODE);
+
+    byte_swap_array(addr, pdrs->cur, nelem, elsize);
+
+    pdrs->cur += len;
+    pdrs->space -= len;
+    return TRUE;
+}
+
+/*
+ *  pdrmem_getinline(): Returns a pointer to the next 'len' bytes of the
+ *  buffer and skips over them, as long as they are in local byte order and
+ *  start on an 'align' byte boundary. Otherwise returns NULL and leaves
+ *  the position unchanged.
+ */
+static char * pdrmem_getinline(PDR *pdrs, uint64_t len, uint32_t align)
+{
+    char *ret = pdrs->cur;
+
+    if( len > pdrs->space ) {
+        return NULL;
+    }
+    if( (align > 1) && (((unsigned long)ret) % align) ) {
+        return NULL;
+    }
+    assert(pdrs->p_op == PDR_DECODE);
+
+    pdrs->cur += len;
+    pdrs->space -= len;
+    return ret;
+}
+
+static char * pdrmem_getinline_swap(PDR * UNUSED(pdrs), uint64_t UNUSED(len),
+                                    uint32_t UNUSED(align))
+{
+    return NULL;
+}
+
 static uint64_t pdrmem_getpos( PDR *pdrs )
 {
     unsigned long diff = ((unsigned long)pdrs->cur) - ((unsigned long)pdrs->base);
@@ -386,6 +472,9 @@ static struct pdr_ops pdrmem_ops = {
     pdrmem_getdouble,
     pdrmem_putbytes,
     pdrmem_getbytes,
+    pdrmem_putvector,
+    pdrmem_getvector,
+    pdrmem_getinline,
     pdrmem_setpos,
     pdrmem_getpos,
     pdrmem_destroy
@@ -406,6 +495,9 @@ static struct pdr_ops pdrmem_ops_swap = {
     pdrmem_getdouble_swap,
     pdrmem_putbytes,
     pdrmem_getbytes,
+    pdrmem_putvector,
+    pdrmem_getvector_swap,
+    pdrmem_getinline_swap,
     pdrmem_setpos,
     pdrmem_getpos,
     pdrmem_destroy
@@ -76,6 +76,23 @@ static bool_t _getbytes(PDR * UNUSED(pdrs), char * UNUSED(c), uint64_t UNUSED(u)
     return FALSE;
 }
 
+static bool_t _putvector(PDR *pdrs, char * UNUSED(c), uint64_t nelem, uint32_t elsize)
+{
+    pdrs->space += nelem*elsize;
+    return TRUE;
+}
+static bool_t _getvector(PDR * UNUSED(pdrs), char * UNUSED(c), uint64_t UNUSED(n),
+                         uint32_t UNUSED(e))
+{
+    return FALSE;
+}
+
+static char * _getinline(PDR * UNUSED(pdrs), uint64_t UNUSED(len),
+                         uint32_t UNUSED(align))
+{
+    return NULL;
+}
+
 static uint64_t _getpos(PDR *pdrs)
 {
     return pdrs->space;
@@ -108,6 +125,9 @@ static struct pdr_ops _ops = {
     _getdouble,
     _putbytes,
     _getbytes,
+    _putvector,
+    _getvector,
+    _getinline,
     _setpos,
     _getpos,
     _destroy
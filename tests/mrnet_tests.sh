@@ -66,9 +66,14 @@ run_test()
     # $3, 3rd arg, says to use local or remote topology files
     # $4, 4th arg, specifies the shared object file, if applicable
     # $5, 5th arg, says to use standard or lightweight output file names
+    # $6, 6th arg, optional MRNet environment settings (e.g., "MRNET_IO_ENGINE=all")
     front_end=$1
     back_end=$2
     test=`basename $front_end`
+    run_env=$6
+    if [ "$run_env" != "" ]; then
+        test="$test-`echo $run_env | sed -e 's/MRNET_//g' -e 's/[^A-Za-z0-9_]/_/g'`"
+    fi
 
     for (( idx = 0 ; idx < ${#topologies[@]}; idx++ ));
     do
@@ -104,16 +109,16 @@ run_test()
 
             case "$front_end" in
             "test_DynamicFilters_FE" )
-                $front_end $4 $topology_file $back_end > $outfile 2> $logfile
+                env $run_env $front_end $4 $topology_file $back_end > $outfile 2> $logfile
                 ;;
             "microbench_FE" )
-                $front_end 5 500 $topology_file $back_end > $outfile 2> $logfile
+                env $run_env $front_end 5 500 $topology_file $back_end > $outfile 2> $logfile
                 ;;
             "test_MultStreams_FE" )
-                $front_end $topology_file 5 $back_end > $outfile 2> $logfile
+                env $run_env $front_end $topology_file 5 $back_end > $outfile 2> $logfile
                 ;;
             * )
-                $front_end $topology_file $back_end > $outfile 2> $logfile
+                env $run_env $front_end $topology_file $back_end > $outfile 2> $logfile
                 ;;
             esac
             if [ "$?" = 0 ]; then
@@ -220,10 +225,14 @@ if [ "$local" == "true" ]; then
     echo
     run_test "test_arrays_FE" "test_arrays_BE" "local" "" ""
     echo
+    run_test "test_arrays_FE" "test_arrays_BE" "local" "" "" "MRNET_IO_ENGINE=all MRNET_IO_ENGINE_WORKERS=2"
+    echo
     run_test "test_MultStreams_FE" "test_MultStreams_BE" "local" "" ""
     echo 
     run_test "test_NativeFilters_FE" "test_NativeFilters_BE" "local" "" "" 
     echo
+    run_test "test_NativeFilters_FE" "test_NativeFilters_BE" "local" "" "" "MRNET_FILTER_THREADS=FE:2,CP:2"
+    echo
     if [ "$sharedobject" != "" ]; then
         run_test "test_DynamicFilters_FE" "test_DynamicFilters_BE" "local" $sharedobject ""
         echo
@@ -235,6 +244,8 @@ if [ "$local" == "true" ]; then
         echo
         run_test "test_arrays_FE" "test_arrays_BE_lightweight" "local" "" "lightweight" 
         echo
+        run_test "test_arrays_FE" "test_arrays_BE_lightweight" "local" "" "lightweight" "MRNET_IO_ENGINE=all MRNET_IO_ENGINE_WORKERS=2"
+        echo
         run_test "test_MultStreams_FE" "test_MultStreams_BE_lightweight" "local" "" "lightweight" 
         echo
         run_test "test_NativeFilters_FE" "test_NativeFilters_BE_lightweight" "local" "" "lightweight"
@@ -195,6 +195,63 @@ int main(int argc, char **argv)
             }
 	    free(recv_string);
             break;
+        case PROT_PRIO_START: {
+#if defined(DEBUG)
+            fprintf( stderr, "Processing PROT_PRIO_START ...\n");
+#endif
+            unsigned int norm_id;
+            int num_backlog, ahead = 0, total;
+            Stream_t * norm_stream = NULL;
+            Packet_t * prio_pkt;
+            int prio_tag;
+            if( Packet_unpack(pkt, "%ud %d", &norm_id, &num_backlog ) == -1 ) {
+                fprintf(stderr, "stream_unpack(%%ud %%d) failure\n");
+                success = 0;
+                break;
+            }
+            norm_stream = Network_get_Stream(net, norm_id);
+            if( norm_stream == NULL ) {
+                fprintf(stderr, "Network_get_Stream(%u) failure\n", norm_id);
+                success = 0;
+                break;
+            }
+
+            // count the backlog packets received ahead of the high priority one
+            prio_pkt = (Packet_t*) calloc( (size_t)1, sizeof(Packet_t) );
+            if( (Stream_recv(stream, &prio_tag, prio_pkt, true) != 1) ||
+                (prio_tag != PROT_PRIO_URGENT) ) {
+                fprintf(stderr, "stream_recv(urgent) failure\n");
+                delete_Packet_t(prio_pkt);
+                success = 0;
+                break;
+            }
+            delete_Packet_t(prio_pkt);
+            while( (ahead < num_backlog) &&
+                   ((prio_pkt = Stream_get_IncomingPacket(norm_stream)) != NULL) ) {
+                delete_Packet_t(prio_pkt);
+                ahead++;
+            }
+            if( (Stream_send(stream, PROT_PRIO_URGENT, "%d", ahead) == -1) ||
+                (Stream_flush(stream) == -1) ) {
+                fprintf(stderr, "stream_send(urgent) failure\n");
+                success = 0;
+            }
+
+            for( total = ahead; total < num_backlog; total++ ) {
+                prio_pkt = (Packet_t*) calloc( (size_t)1, sizeof(Packet_t) );
+                if( Stream_recv(norm_stream, &prio_tag, prio_pkt, true) != 1 ) {
+                    free(prio_pkt);
+                    break;
+                }
+                delete_Packet_t(prio_pkt);
+            }
+            if( (Stream_send(norm_stream, PROT_PRIO_BACKLOG, "%d", total) == -1) ||
+                (Stream_flush(norm_stream) == -1) ) {
+                fprintf(stderr, "stream_send(backlog) failure\n");
+                success = 0;
+            }
+            break;
+        }
         case PROT_EXIT:
 #if defined(DEBUG)
             fprintf( stderr, "Processing PROT_EXIT ...\n");
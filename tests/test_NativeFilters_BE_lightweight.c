@@ -13,6 +13,151 @@
 #include "mrnet_lightweight/MRNet.h"
 #include "test_NativeFilters_lightweight.h"
 
+static int send_Array( Stream_t * stream, int tag, DataType typ, Rank rank )
+{
+    int avg = ( tag == PROT_ARRAY_AVG );
+    int ret = -1;
+    unsigned int k;
+
+    switch( typ ) {
+    case CHAR_T: {
+        char arr[ ARRAY_FILTER_LEN ];
+        for( k = 0; k < ARRAY_FILTER_LEN; k++ )
+            arr[k] = (char) ARRAY_FILTER_VAL(rank, k);
+        if( avg )
+            ret = Stream_send(stream, tag, "%ac %d", arr, ARRAY_FILTER_LEN,
+                              ARRAY_FILTER_CHAR_COUNT);
+        break;
+    }
+    case INT32_T: {
+        int32_t arr[ ARRAY_FILTER_LEN ];
+        for( k = 0; k < ARRAY_FILTER_LEN; k++ )
+            arr[k] = (int32_t) ARRAY_FILTER_VAL(rank, k);
+        if( avg )
+            ret = Stream_send(stream, tag, "%ad %d", arr, ARRAY_FILTER_LEN, 1);
+        else
+            ret = Stream_send(stream, tag, "%ad", arr, ARRAY_FILTER_LEN);
+        break;
+    }
+    case UINT64_T: {
+        uint64_t arr[ ARRAY_FILTER_LEN ];
+        uint64_t len = ARRAY_FILTER_LEN;
+        for( k = 0; k < ARRAY_FILTER_LEN; k++ )
+            arr[k] = (uint64_t) ARRAY_FILTER_VAL(rank, k);
+        if( avg )
+            ret = Stream_send(stream, tag, "%Auld %d", arr, len, 1);
+        else
+            ret = Stream_send(stream, tag, "%Auld", arr, len);
+        break;
+    }
+    case DOUBLE_T: {
+        double arr[ ARRAY_FILTER_LEN ];
+        for( k = 0; k < ARRAY_FILTER_LEN; k++ )
+            arr[k] = ARRAY_FILTER_VAL(rank, k) + 0.5;
+        if( avg )
+            ret = Stream_send(stream, tag, "%alf %d", arr, ARRAY_FILTER_LEN, 1);
+        else
+            ret = Stream_send(stream, tag, "%alf", arr, ARRAY_FILTER_LEN);
+        break;
+    }
+    default:
+        break;
+    }
+    return ret;
+}
+
+static int send_Fields( Stream_t * stream, Rank rank )
+{
+    int32_t arr[ FIELD_FILTER_LEN ];
+    uint64_t count = 1;
+    unsigned int k;
+
+    for( k = 0; k < FIELD_FILTER_LEN; k++ )
+        arr[k] = (int32_t) ARRAY_FILTER_VAL(rank, k);
+
+    return Stream_send(stream, PROT_FIELDS, FIELD_FILTER_FMT, count,
+                       rank + 0.5, rank * 2.0, FIELD_FILTER_FLAG(rank),
+                       FIELD_FILTER_STR, FIELD_FILTER_STR,
+                       arr, FIELD_FILTER_LEN);
+}
+
+static int send_Quantiles( Stream_t * stream, Rank rank )
+{
+    int ret;
+    unsigned int k;
+    QuantileSketch_t * sketch = new_QuantileSketch_t(QUANTILE_FILTER_ACCURACY,
+                                                     QUANTILE_FILTER_BUCKETS);
+    if( sketch == NULL )
+        return -1;
+
+    for( k = 0; k < QUANTILE_FILTER_SAMPLES; k++ )
+        QuantileSketch_add(sketch, QUANTILE_FILTER_VAL(rank, k), 1);
+    ret = QuantileSketch_send(sketch, stream, PROT_QUANTILE);
+    delete_QuantileSketch_t(sketch);
+    return ret;
+}
+
+static int send_TopK( Stream_t * stream, Rank rank )
+{
+    int ret;
+    unsigned int j;
+    TopKSketch_t * sketch = new_TopKSketch_t(TOPK_FILTER_K, TOPK_FILTER_WIDTH,
+                                             TOPK_FILTER_DEPTH);
+    if( sketch == NULL )
+        return -1;
+
+    /* heavy keys in two halves, around the others */
+    for( j = 0; j < TOPK_FILTER_HEAVY; j++ )
+        TopKSketch_add(sketch, TOPK_FILTER_KEY(j), TOPK_FILTER_COUNT(rank, j) / 2);
+    for( j = 0; j < TOPK_FILTER_LIGHT; j++ )
+        TopKSketch_add(sketch, TOPK_FILTER_KEY(TOPK_FILTER_HEAVY + 1000000 + j), 1);
+    TopKSketch_add(sketch, TOPK_FILTER_KEY(TOPK_FILTER_HEAVY + rank),
+                   TOPK_FILTER_LOCAL_COUNT);
+    for( j = 0; j < TOPK_FILTER_HEAVY; j++ )
+        TopKSketch_add(sketch, TOPK_FILTER_KEY(j),
+                       TOPK_FILTER_COUNT(rank, j) - TOPK_FILTER_COUNT(rank, j) / 2);
+    ret = TopKSketch_send(sketch, stream, PROT_TOPK);
+    delete_TopKSketch_t(sketch);
+    return ret;
+}
+
+static int send_HyperLogLog( Stream_t * stream, Rank rank )
+{
+    int ret;
+    uint64_t n, first = (uint64_t)rank * HLL_FILTER_STRIDE;
+    char id[64];
+    HyperLogLog_t * sketch = new_HyperLogLog_t(HLL_FILTER_PRECISION);
+    if( sketch == NULL )
+        return -1;
+
+    for( n = first; n < first + HLL_FILTER_IDS; n++ ) {
+        if( n % 2 == 0 ) {
+            sprintf(id, "id-%" PRIu64, n);
+            HyperLogLog_add_String(sketch, id);
+        }
+        else
+            HyperLogLog_add_Value(sketch, n);
+    }
+    ret = HyperLogLog_send(sketch, stream, PROT_HLL);
+    delete_HyperLogLog_t(sketch);
+    return ret;
+}
+
+static int send_EqClasses( Stream_t * stream, Rank rank )
+{
+    unsigned int values[2];
+    unsigned int counts[2] = { 1, 1 };
+    unsigned int ranges[4];
+
+    values[0] = EQ_CLASS_VAL(rank);
+    values[1] = EQ_CLASS_ALL;
+    ranges[0] = ranges[1] = rank;
+    ranges[2] = rank * EQ_CLASS_SPAN;
+    ranges[3] = rank * EQ_CLASS_SPAN + EQ_CLASS_SPAN - 1;
+    return Stream_send(stream, PROT_EQ_CLASS, "%aud %aud %aud", values, 2,
+                       counts, 2, ranges, 4);
+}
+
 int main(int argc, char **argv)
 {
     Stream_t * stream;
@@ -117,6 +262,61 @@ int main(int argc, char **argv)
                 }
             }
             break;
+        case PROT_ARRAY:
+        case PROT_ARRAY_AVG:
+            fprintf( stdout, "Processing ARRAY ...\n");
+            if( send_Array(stream, tag, typ, Network_get_LocalRank(net)) == -1 ){
+                fprintf(stderr, "stream_send(array) failure\n");
+            }
+            else if( Stream_flush(stream) == -1 ){
+                fprintf(stderr, "stream_flush() failure\n");
+            }
+            break;
+        case PROT_FIELDS:
+            fprintf( stdout, "Processing FIELDS ...\n");
+            if( send_Fields(stream, Network_get_LocalRank(net)) == -1 ){
+                fprintf(stderr, "stream_send(fields) failure\n");
+            }
+            else if( Stream_flush(stream) == -1 ){
+                fprintf(stderr, "stream_flush() failure\n");
+            }
+            break;
+        case PROT_QUANTILE:
+            fprintf( stdout, "Processing QUANTILE ...\n");
+            if( send_Quantiles(stream, Network_get_LocalRank(net)) == -1 ){
+                fprintf(stderr, "stream_send(quantiles) failure\n");
+            }
+            else if( Stream_flush(stream) == -1 ){
+                fprintf(stderr, "stream_flush() failure\n");
+            }
+            break;
+        case PROT_TOPK:
+            fprintf( stdout, "Processing TOPK ...\n");
+            if( send_TopK(stream, Network_get_LocalRank(net)) == -1 ){
+                fprintf(stderr, "stream_send(topk) failure\n");
+            }
+            else if( Stream_flush(stream) == -1 ){
+                fprintf(stderr, "stream_flush() failure\n");
+            }
+            break;
+        case PROT_HLL:
+            fprintf( stdout, "Processing HLL ...\n");
+            if( send_HyperLogLog(stream, Network_get_LocalRank(net)) == -1 ){
+                fprintf(stderr, "stream_send(hll) failure\n");
+            }
+            else if( Stream_flush(stream) == -1 ){
+                fprintf(stderr, "stream_flush() failure\n");
+            }
+            break;
+        case PROT_EQ_CLASS:
+            fprintf( stdout, "Processing EQ_CLASS ...\n");
+            if( send_EqClasses(stream, Network_get_LocalRank(net)) == -1 ){
+                fprintf(stderr, "stream_send(eq classes) failure\n");
+            }
+            else if( Stream_flush(stream) == -1 ){
+                fprintf(stderr, "stream_flush() failure\n");
+            }
+            break;
         case PROT_EXIT:
             fprintf( stdout, "Processing PROT_EXIT ...\n");
             break;
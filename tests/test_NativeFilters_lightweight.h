@@ -8,7 +8,9 @@
 
 #include "mrnet_lightweight/Types.h"
 
-typedef enum { PROT_EXIT=FirstApplicationTag, PROT_SUM, PROT_MAX } Protocol;
+typedef enum { PROT_EXIT=FirstApplicationTag, PROT_SUM, PROT_MAX,
+               PROT_ARRAY, PROT_ARRAY_AVG, PROT_FIELDS,
+               PROT_QUANTILE, PROT_TOPK, PROT_HLL, PROT_EQ_CLASS } Protocol;
 
 const char_t CHARVAL=7;
 const uchar_t UCHARVAL=7;
@@ -21,4 +23,65 @@ const uint64_t UINT64VAL=177;
 const float FLOATVAL=(float)123.450;
 const double DOUBLEVAL=123.45678;
 
+/* arrays for the element-wise array filters. PROT_ARRAY_AVG arrays are
+   followed by a count of 1, or of ARRAY_FILTER_CHAR_COUNT for CHAR_T, so
+   that weights and weighted sums do not fit the element type. Element
+   types are sent as "%ac" (CHAR_T, averages only), "%ad" (INT32_T),
+   "%Auld" (UINT64_T) and "%alf" (DOUBLE_T, with 0.5 added) */
+#define ARRAY_FILTER_LEN 1000
+#define ARRAY_FILTER_VAL(rank, k) ( ((k) + (rank)) % 16 )
+#define ARRAY_FILTER_CHAR_COUNT 200
+
+/* PROT_FIELDS packets for the per-field reduction filter. Each back-end
+   sends a count of 1, rank + 0.5, rank * 2.0, FIELD_FILTER_FLAG(rank),
+   FIELD_FILTER_STR twice, and the first FIELD_FILTER_LEN array values */
+#define FIELD_FILTER_FMT "%uld %lf %lf %d %s %s %ad"
+#define FIELD_FILTER_OPS "sum sum max bor first concat min"
+#define FIELD_FILTER_STR "be"
+#define FIELD_FILTER_LEN 16
+#define FIELD_FILTER_FLAG(rank) ( 1 << ((rank) % 31) )
+
+/* PROT_QUANTILE sketches. Each back-end adds QUANTILE_FILTER_SAMPLES
+   samples, one of them 0, spread over six orders of magnitude. That takes
+   about 345 buckets, so the lowest (below 0.04) are merged */
+#define QUANTILE_FILTER_ACCURACY 0.02
+#define QUANTILE_FILTER_BUCKETS 256
+#define QUANTILE_FILTER_SAMPLES 1000
+#define QUANTILE_FILTER_VAL(rank, k) \
+    ( (k) ? 0.001 * (double)( 1 + ((k) * 7919 + (rank) * 104729) % 1000003 ) : 0.0 )
+
+/* PROT_TOPK sketches of TOPK_FILTER_K candidates in TOPK_FILTER_DEPTH rows
+   of TOPK_FILTER_WIDTH counters, which the filter folds into the smaller
+   TOPK_FILTER_OUT_* sketch when given as its parameters. Each back-end
+   adds TOPK_FILTER_COUNT(rank, j) of heavy key j < TOPK_FILTER_HEAVY,
+   TOPK_FILTER_LOCAL_COUNT of its own key TOPK_FILTER_HEAVY + rank and 1
+   of each of the TOPK_FILTER_LIGHT keys from TOPK_FILTER_HEAVY + 1000000 */
+#define TOPK_FILTER_K 16
+#define TOPK_FILTER_WIDTH 1024
+#define TOPK_FILTER_DEPTH 4
+#define TOPK_FILTER_OUT_K 8
+#define TOPK_FILTER_OUT_WIDTH 256
+#define TOPK_FILTER_OUT_DEPTH 3
+#define TOPK_FILTER_HEAVY 8
+#define TOPK_FILTER_LIGHT 4000
+#define TOPK_FILTER_LOCAL_COUNT 150
+#define TOPK_FILTER_KEY(j) ( (uint64_t)(j) * 2654435761u + 17 )
+#define TOPK_FILTER_COUNT(rank, j) \
+    ( (uint64_t)( (TOPK_FILTER_HEAVY - (j)) * 200 + ((rank) % 5) * 10 ) )
+
+/* PROT_HLL sketches. Back-end rank r adds the HLL_FILTER_IDS identifiers
+   n from r * HLL_FILTER_STRIDE on, as "id-<n>" strings for even n and as
+   values n otherwise, so those of nearby ranks overlap */
+#define HLL_FILTER_PRECISION 12
+#define HLL_FILTER_IDS 5000
+#define HLL_FILTER_STRIDE 2000
+
+/* PROT_EQ_CLASS range classes. Each back-end sends its rank as the range
+   [rank, rank] of class EQ_CLASS_VAL(rank), and the range of EQ_CLASS_SPAN
+   ranks from rank * EQ_CLASS_SPAN of class EQ_CLASS_ALL, which coalesces
+   with those of the neighbouring ranks */
+#define EQ_CLASS_VAL(rank) ( ((rank) / 2) % 3 )
+#define EQ_CLASS_ALL 1000
+#define EQ_CLASS_SPAN 10
+
 #endif /* test_nativefilters_lightweight_h */
@@ -14,6 +14,8 @@ typedef enum {PROT_EXIT=FirstApplicationTag,
               PROT_INT, PROT_UINT,
               PROT_LONG, PROT_ULONG,
               PROT_FLOAT, PROT_DOUBLE,
-              PROT_STRING, PROT_ALL} Protocol;
+              PROT_STRING, PROT_ALL,
+              PROT_PRIO_START, PROT_PRIO_BACKLOG,
+              PROT_PRIO_URGENT} Protocol;
 
 #endif /* test_basic_lightweight_h */
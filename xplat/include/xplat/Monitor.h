@@ -31,6 +31,7 @@ public:
         virtual int RegisterCondition( unsigned int condid ) = 0;
         virtual int WaitOnCondition( unsigned int condid ) = 0;
         virtual int TimedWaitOnCondition( unsigned int condid, int milliseconds) = 0;
+        virtual int TimedWaitOnConditionUsec( unsigned int condid, long microseconds) = 0;
         virtual int SignalCondition( unsigned int condid ) = 0;
         virtual int BroadcastCondition( unsigned int condid ) = 0;
     };
@@ -50,6 +51,7 @@ public:
     virtual int RegisterCondition( unsigned int condid );
     virtual int WaitOnCondition( unsigned int condid );
     virtual int TimedWaitOnCondition( unsigned int condid, int milliseconds);
+    virtual int TimedWaitOnConditionUsec( unsigned int condid, long microseconds);
     virtual int SignalCondition( unsigned int condid );
     virtual int BroadcastCondition( unsigned int condid );
 };
@@ -62,6 +62,12 @@ namespace SocketUtils
                   NCBuf* bufs, 
                   unsigned int nBufs );
 
+    // single gathered send that never blocks, returns the number of bytes
+    // written, which is 0 if the socket cannot take any data now (-1 on error)
+    ssize_t SendAvailable( XPlat_Socket s, 
+                           NCBuf* bufs, 
+                           unsigned int nBufs );
+
     ssize_t Recv( XPlat_Socket s, 
                   NCBuf* bufs, 
                   unsigned int nBufs );
@@ -74,6 +80,18 @@ namespace SocketUtils
                   void *buf, 
                   size_t count );
 
+    // single receive of at most count bytes, returns as soon as any
+    // data is available (-1 on error or connection closed)
+    ssize_t RecvSome( XPlat_Socket s, 
+                      void *buf, 
+                      size_t count );
+
+    // single receive of at most count bytes that never blocks, returns
+    // 0 if no data is available (-1 on error or connection closed)
+    ssize_t RecvAvailable( XPlat_Socket s, 
+                           void *buf, 
+                           size_t count );
+
 } // namespace SocketUtils
 
 } // namespace XPlat
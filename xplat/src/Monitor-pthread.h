@@ -36,6 +36,7 @@ public:
     virtual int RegisterCondition( unsigned int cvid );
     virtual int WaitOnCondition( unsigned int cvid );
     virtual int TimedWaitOnCondition( unsigned int cvid, int milliseconds );
+    virtual int TimedWaitOnConditionUsec( unsigned int cvid, long microseconds );
     virtual int SignalCondition( unsigned int cvid );
     virtual int BroadcastCondition( unsigned int cvid );
 };